@@ -0,0 +1,867 @@
+/*
+ * main.c
+ *
+ *  Benchmark del kernel JAMMOS
+ *
+ *  Mide con el contador de ciclos del port (portGetCycles) el costo de las operaciones del
+ *  kernel y emite los resultados por la salida estándar (semihosting en qemu_m3), una línea
+ *  por medición con el formato:
+ *
+ *      BENCH name=<medición> [size=<bytes>] n=<muestras> min=<ciclos> avg=<ciclos> max=<ciclos>
+ *
+ *  salvo las mediciones que se obtienen de un único total (costos promedio por elemento y
+ *  tasas por segundo), que no tienen min ni max y se informan con el formato:
+ *
+ *      BENCH_RATE name=<medición> [size=<bytes>] n=<eventos> value=<valor> better=<higher|lower>
+ *
+ *  donde n es la cantidad de eventos contados y better indica si un valor mayor es una mejora.
+ *  Al final se emite una línea "BENCH_DONE". tools/jammos_bench.py compara dos ejecuciones.
+ *
+ *  Mediciones:
+ *   - context_switch: desde el Give de un semáforo y osForceSchCC en una tarea hasta que la
+ *     tarea de mayor prioridad que lo esperaba está en ejecución.
+ *   - queue_set: como context_switch, pero la tarea de mayor prioridad espera el semáforo como
+ *     parte de un conjunto (osWaitQueueSet) junto con una cola, y luego lo toma sin esperar.
+ *   - sem_pingpong: ida y vuelta entre dos tareas de igual prioridad con dos semáforos.
+ *   - queue: costo promedio por elemento (BENCH_RATE) de enviar BENCH_QUEUE_ITEMS elementos entre dos tareas para
+ *     distintos tamaños de elemento.
+ *   - stream: costo promedio por byte (BENCH_RATE) de enviar BENCH_QUEUE_ITEMS bytes entre dos tareas por un buffer
+ *     de bytes, escribiendo bloques de size bytes con nivel de disparo size. Informa además
+ *     los cambios de contexto (switches), comparable con queue size=1.
+ *   - fanout_topic / fanout_queue: desde la publicación de un elemento hasta que los size
+ *     suscriptores de mayor prioridad lo leyeron, con un tópico (una copia y un único
+ *     scheduling) o con una cola por suscriptor (size copias).
+ *   - delay_wake: tiempo entre despertares sucesivos de osDelay(1), comparado con period.
+ *   - tick_handler: desde el inicio del tick hasta tickHook, es decir el costo del handler de
+ *     SysTick con el scheduler, con DYNAMIC_TASK_NUMBER tareas bloqueadas en todas las
+ *     prioridades que el scheduler recorre en cada tick.
+ *   - irq_latency: desde el disparo de una interrupción por software hasta que la tarea que
+ *     espera el semáforo liberado por la ISR está en ejecución.
+ *   - periodic_fp / periodic_edf: tiempo de respuesta de los trabajos de un conjunto de tareas
+ *     periódicas con utilización de ~91 % que no es planificable con prioridades fijas
+ *     (rate monotonic) pero sí con EDF. Informa además los deadlines perdidos (misses) y la
+ *     utilización alcanzada por las tareas periódicas en centésimas de porcentaje (util). El
+ *     nombre depende de la política con que se compiló el kernel (JAMMOS_SCHED_EDF).
+ *   - pipeline_switches / pipeline_switches_pt: cambios de contexto por segundo (BENCH_RATE)
+ *     de un productor que genera un elemento cada 200 us y un consumidor de mayor prioridad,
+ *     sin y con umbral de desalojo en el productor (osSetTaskThreshold). n es la cantidad de
+ *     cambios de contexto.
+ *   - seqvalue_write / seqvalue_read: costo de publicar y de leer una muestra de size bytes en
+ *     un valor de última muestra, sin secciones críticas (comparable con queue).
+ *   - readers_sem / readers_rwlock: lecturas por segundo (BENCH_RATE) de size tareas lectoras que mantienen el dato protegido durante un tick, con un semáforo o con
+ *     un lock de lectura/escritura. n es la cantidad de lecturas.
+ *   - tt_dispatch: solo con JAMMOS_SCHED_TT, desde el inicio de cada marco menor de una tabla
+ *     de ejecutivo cíclico hasta que la tarea del marco está en ejecución. Informa además los
+ *     marcos excedidos (overruns).
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "JAMMOS.h"
+#include "JAMMOS_API.h"
+#include "JAMMOS_IRQ.h"
+#include "JAMMOS_PUBSUB.h"
+#include "JAMMOS_SET.h"
+
+#define BENCH_ITERATIONS	1000
+#define BENCH_QUEUE_ITEMS	2000
+#define BENCH_DELAYS		100
+#define BENCH_STREAM_BYTES	64
+#define FANOUT_MAX			DYNAMIC_TASK_NUMBER
+#define FANOUT_DEPTH		4
+#define BENCH_HYPERPERIODS	4
+#define PERIODIC_TASKS		3
+#define PIPELINE_TICKS		300
+#define READERS_TICKS		200
+#define SEQVALUE_SIZE		16
+#define TT_MINOR_TICKS		2
+#define TT_FRAMES			4
+#define TT_TICKS			400
+
+#ifndef BENCH_IRQ
+#define BENCH_IRQ			0		//línea de interrupción disparada por software
+#endif
+
+#define PRIORITY_HIGH		1
+#define PRIORITY_RUNNER		2
+
+/*
+ * Acumulador de las muestras de una medición
+ */
+struct _benchStats {
+	uint32_t count;
+	uint32_t minCycles;
+	uint32_t maxCycles;
+	uint64_t totalCycles;
+};
+
+typedef struct _benchStats benchStats;
+
+OS_TASK(runner);
+static semaphore semA, semB, semDone;
+static queue benchQueue;
+static streamBuffer benchStream;
+static uint8_t benchStreamStorage[BENCH_STREAM_BYTES];
+static queueSet benchSet;
+static rwLock benchLock;
+OS_SEQVALUE_STATIC(benchValue, SEQVALUE_SIZE);
+static volatile uint32_t readsDone;
+static topic fanoutTopic;
+static uint8_t fanoutSlots[FANOUT_DEPTH * sizeof(uint32_t)];
+static subscriber fanoutSub[FANOUT_MAX];
+static queue fanoutQueue[FANOUT_MAX];
+static volatile uint8_t fanoutStarted;
+static benchStats stats;
+static volatile uint32_t startCycles;
+static volatile uint32_t queueReceived;
+static volatile bool tickSampling;
+
+/*
+ * Conjunto de tareas periódicas: período y tiempo de ejecución de cada trabajo en ticks,
+ * U = 3/10 + 5/15 + 7/25 = 0.913 con hiperperíodo de 150 ticks. Con rate monotonic el tiempo de
+ * respuesta de la tercera tarea es 26 ticks y supera su deadline de 25 ticks
+ */
+static const uint32_t periodicPeriod[PERIODIC_TASKS] = {10, 15, 25};
+static const uint32_t periodicWcet[PERIODIC_TASKS] = {3, 5, 7};
+static task *periodicTask[PERIODIC_TASKS];
+static volatile uint32_t periodicEnd;
+static volatile uint32_t periodicMisses;
+static volatile uint32_t periodicUtil;
+
+static void statsReset(benchStats *st)
+{
+	st->count = 0;
+	st->minCycles = UINT32_MAX;
+	st->maxCycles = 0;
+	st->totalCycles = 0;
+}
+
+static void statsAdd(benchStats *st, uint32_t cycles)
+{
+	if(cycles < st->minCycles)
+		st->minCycles = cycles;
+	if(cycles > st->maxCycles)
+		st->maxCycles = cycles;
+	st->totalCycles += cycles;
+	st->count++;
+}
+
+static void statsPrint(const char *name, const char *extra, benchStats *st)
+{
+	printf("BENCH name=%s%s n=%u min=%u avg=%u max=%u\n", name, extra, (unsigned)st->count,
+			(unsigned)st->minCycles, (unsigned)(st->count ? st->totalCycles / st->count : 0),
+			(unsigned)st->maxCycles);
+	fflush(stdout);
+}
+
+static void ratePrint(const char *name, const char *extra, uint32_t count, uint32_t value,
+		bool higherIsBetter)
+{
+	printf("BENCH_RATE name=%s%s n=%u value=%u better=%s\n", name, extra, (unsigned)count,
+			(unsigned)value, higherIsBetter ? "higher" : "lower");
+	fflush(stdout);
+}
+
+/*==================[context_switch / irq_latency]===========================*/
+
+/*
+ * Tarea de mayor prioridad que el runner: registra el tiempo desde startCycles hasta que
+ * vuelve a ejecutarse luego de tomar semA
+ */
+static void wakeTask(void)
+{
+	while(1)  {
+		osTakeSemaphore(&semA, OS_WAIT_FOREVER);
+		statsAdd(&stats, portGetCycles() - startCycles);
+	}
+}
+
+static void benchIsr(void)
+{
+	osGiveSemaphore(&semA);
+}
+
+static void benchContextSwitch(void)
+{
+	task *helper;
+	uint32_t i;
+
+	osInitSemaphore(&semA);
+	statsReset(&stats);
+	helper = osCreateTask(wakeTask, PRIORITY_HIGH);
+	osForceSchCC();				//la tarea auxiliar se bloquea en semA
+
+	for(i = 0; i < BENCH_ITERATIONS; i++)  {
+		startCycles = portGetCycles();
+		osGiveSemaphore(&semA);
+		osForceSchCC();
+	}
+
+	osDeleteTask(helper);
+	statsPrint("context_switch", "", &stats);
+}
+
+static void setWakeTask(void)
+{
+	while(1)  {
+		if(osWaitQueueSet(&benchSet, OS_WAIT_FOREVER) == &semA &&
+				osTakeSemaphore(&semA, OS_NO_WAIT))
+			statsAdd(&stats, portGetCycles() - startCycles);
+	}
+}
+
+static void benchQueueSet(void)
+{
+	task *helper;
+	uint32_t i;
+
+	osInitSemaphore(&semA);
+	osInitQueue(&benchQueue, sizeof(uint32_t));
+	osInitQueueSet(&benchSet);
+	osAddToQueueSet(&benchSet, SET_QUEUE, &benchQueue);
+	osAddToQueueSet(&benchSet, SET_SEMAPHORE, &semA);
+	statsReset(&stats);
+	helper = osCreateTask(setWakeTask, PRIORITY_HIGH);
+	osForceSchCC();				//la tarea auxiliar se bloquea en el conjunto
+
+	for(i = 0; i < BENCH_ITERATIONS; i++)  {
+		startCycles = portGetCycles();
+		osGiveSemaphore(&semA);
+		osForceSchCC();
+	}
+
+	osDeleteTask(helper);
+	statsPrint("queue_set", "", &stats);
+}
+
+static void benchIrqLatency(void)
+{
+	task *helper;
+	uint32_t i;
+
+	osInitSemaphore(&semA);
+	statsReset(&stats);
+	helper = osCreateTask(wakeTask, PRIORITY_HIGH);
+	osForceSchCC();
+
+	for(i = 0; i < BENCH_ITERATIONS; i++)  {
+		startCycles = portGetCycles();
+		portRaiseIrq(BENCH_IRQ);
+	}
+
+	osDeleteTask(helper);
+	statsPrint("irq_latency", "", &stats);
+}
+
+/*==================[sem_pingpong]===========================================*/
+
+static void pongTask(void)
+{
+	while(1)  {
+		osTakeSemaphore(&semA, OS_WAIT_FOREVER);
+		osGiveSemaphore(&semB);
+	}
+}
+
+static void benchSemPingPong(void)
+{
+	task *helper;
+	uint32_t i;
+	uint32_t start;
+
+	osInitSemaphore(&semA);
+	osInitSemaphore(&semB);
+	statsReset(&stats);
+	helper = osCreateTask(pongTask, PRIORITY_RUNNER);
+
+	for(i = 0; i < BENCH_ITERATIONS; i++)  {
+		start = portGetCycles();
+		osGiveSemaphore(&semA);
+		osTakeSemaphore(&semB, OS_WAIT_FOREVER);
+		statsAdd(&stats, portGetCycles() - start);
+	}
+
+	osDeleteTask(helper);
+	statsPrint("sem_pingpong", "", &stats);
+}
+
+/*==================[queue]==================================================*/
+
+static void consumerTask(void)
+{
+	uint8_t data[QUEUE_SIZE];
+
+	while(1)  {
+		osGetQueue(&benchQueue, data, OS_WAIT_FOREVER);
+		if(++queueReceived == BENCH_QUEUE_ITEMS)
+			osGiveSemaphore(&semDone);
+	}
+}
+
+static void benchQueueSize(uint16_t size)
+{
+	task *helper;
+	uint8_t data[QUEUE_SIZE] = {0};
+	uint32_t i;
+	uint32_t start;
+	uint32_t cycles;
+	char extra[16];
+
+	osInitQueue(&benchQueue, size);
+	osInitSemaphore(&semDone);
+	queueReceived = 0;
+	helper = osCreateTask(consumerTask, PRIORITY_RUNNER);
+
+	start = portGetCycles();
+	for(i = 0; i < BENCH_QUEUE_ITEMS; i++)
+		osPutQueue(&benchQueue, data, OS_WAIT_FOREVER);
+	osTakeSemaphore(&semDone, OS_WAIT_FOREVER);
+
+	/*
+	 * Se mide el total, por lo que se informa solo el costo promedio por elemento
+	 */
+	cycles = portGetCycles() - start;
+
+	osDeleteTask(helper);
+	snprintf(extra, sizeof(extra), " size=%u", size);
+	ratePrint("queue", extra, BENCH_QUEUE_ITEMS, cycles / BENCH_QUEUE_ITEMS, false);
+}
+
+/*==================[stream]=================================================*/
+
+static void streamConsumerTask(void)
+{
+	uint8_t data[BENCH_STREAM_BYTES];
+
+	while(1)  {
+		queueReceived += osReadStream(&benchStream, data, sizeof(data), OS_WAIT_FOREVER);
+		if(queueReceived == BENCH_QUEUE_ITEMS)
+			osGiveSemaphore(&semDone);
+	}
+}
+
+static void benchStreamChunk(uint16_t chunk)
+{
+	task *helper;
+	uint8_t data[BENCH_STREAM_BYTES] = {0};
+	uint32_t i;
+	uint32_t start;
+	uint32_t cycles;
+	uint32_t switches;
+	char extra[32];
+
+	osInitStreamBuffer(&benchStream, benchStreamStorage, sizeof(benchStreamStorage), chunk);
+	osInitSemaphore(&semDone);
+	queueReceived = 0;
+	helper = osCreateTask(streamConsumerTask, PRIORITY_RUNNER);
+
+	switches = osGetContextSwitches();
+	start = portGetCycles();
+	for(i = 0; i < BENCH_QUEUE_ITEMS; i += chunk)
+		osWriteStream(&benchStream, data, chunk, OS_WAIT_FOREVER);
+	osTakeSemaphore(&semDone, OS_WAIT_FOREVER);
+
+	/*
+	 * Como en queue se informa el costo promedio por byte
+	 */
+	cycles = portGetCycles() - start;
+	switches = osGetContextSwitches() - switches;
+
+	osDeleteTask(helper);
+	snprintf(extra, sizeof(extra), " size=%u switches=%u", chunk, (unsigned)switches);
+	ratePrint("stream", extra, BENCH_QUEUE_ITEMS, cycles / BENCH_QUEUE_ITEMS, false);
+}
+
+/*==================[fanout]=================================================*/
+
+/*
+ * Cada suscriptor toma su índice al ejecutarse por primera vez, en el orden de creación
+ */
+static void fanoutTopicTask(void)
+{
+	uint8_t index = fanoutStarted++;
+	uint32_t item;
+
+	while(1)
+		osReadTopic(&fanoutSub[index], &item, OS_WAIT_FOREVER);
+}
+
+static void fanoutQueueTask(void)
+{
+	uint8_t index = fanoutStarted++;
+	uint32_t item;
+
+	while(1)
+		osGetQueue(&fanoutQueue[index], &item, OS_WAIT_FOREVER);
+}
+
+static void benchFanout(uint8_t subscribers, bool useTopic)
+{
+	task *helper[FANOUT_MAX];
+	uint32_t item;
+	uint32_t i;
+	uint8_t j;
+	char extra[16];
+
+	osInitTopic(&fanoutTopic, fanoutSlots, sizeof(uint32_t), FANOUT_DEPTH);
+	fanoutStarted = 0;
+	statsReset(&stats);
+	for(j = 0; j < subscribers; j++)  {
+		osSubscribe(&fanoutSub[j], &fanoutTopic);
+		osInitQueue(&fanoutQueue[j], sizeof(uint32_t));
+		helper[j] = osCreateTask(useTopic ? fanoutTopicTask : fanoutQueueTask, PRIORITY_HIGH);
+	}
+	osForceSchCC();				//los suscriptores se bloquean esperando el primer elemento
+
+	for(i = 0; i < BENCH_ITERATIONS; i++)  {
+		item = i;
+		startCycles = portGetCycles();
+		if(useTopic)
+			osPublish(&fanoutTopic, &item);
+		else
+			for(j = 0; j < subscribers; j++)
+				osPutQueue(&fanoutQueue[j], &item, OS_WAIT_FOREVER);
+		osForceSchCC();
+		statsAdd(&stats, portGetCycles() - startCycles);
+	}
+
+	for(j = 0; j < subscribers; j++)
+		osDeleteTask(helper[j]);
+	snprintf(extra, sizeof(extra), " size=%u", subscribers);
+	statsPrint(useTopic ? "fanout_topic" : "fanout_queue", extra, &stats);
+}
+
+/*==================[delay_wake]=============================================*/
+
+static void benchDelayWake(void)
+{
+	uint32_t i;
+	uint32_t previous;
+	uint32_t now;
+	char extra[24];
+
+	statsReset(&stats);
+	osDelay(1);
+	previous = portGetCycles();
+
+	for(i = 0; i < BENCH_DELAYS; i++)  {
+		osDelay(1);
+		now = portGetCycles();
+		statsAdd(&stats, now - previous);
+		previous = now;
+	}
+
+	snprintf(extra, sizeof(extra), " period=%u", (unsigned)(portCpuFrequency() / OS_TICK_HZ));
+	statsPrint("delay_wake", extra, &stats);
+}
+
+/*==================[tick_handler]===========================================*/
+
+/*
+ * portGetTickCycles devuelve los ciclos desde el inicio del tick actual, tickHook se ejecuta al
+ * final del handler de SysTick luego del scheduler
+ */
+void tickHook(void)
+{
+	if(tickSampling)
+		statsAdd(&stats, portGetTickCycles());
+}
+
+static void blockedTask(void)
+{
+	osTakeSemaphore(&semB, OS_WAIT_FOREVER);
+}
+
+static void benchTickHandler(void)
+{
+	task *blocked[DYNAMIC_TASK_NUMBER];
+	uint8_t i;
+
+	osInitSemaphore(&semB);
+	statsReset(&stats);
+
+	for(i = 0; i < DYNAMIC_TASK_NUMBER; i++)
+		blocked[i] = osCreateTask(blockedTask, PRIORITY_MAX + i % (PRIORITY_MIN + 1));
+	osDelay(1);
+
+	tickSampling = true;
+	osDelay(BENCH_DELAYS);
+	tickSampling = false;
+
+	for(i = 0; i < DYNAMIC_TASK_NUMBER; i++)
+		osDeleteTask(blocked[i]);
+
+	statsPrint("tick_handler", "", &stats);
+}
+
+/*==================[periodic]===============================================*/
+
+/*
+ * Ejecuta la tarea durante la cantidad de ticks indicada. Solo se cuentan los ticks en los que
+ * la tarea estaba en ejecución: si el tick avanzó más de uno entre dos lecturas la tarea fue
+ * desalojada en el primero y se cuenta solo ese. Los trabajos comienzan en un tick (su release o
+ * el fin de un trabajo de mayor prioridad), por lo que cada tick contado es un tick completo.
+ * Medir en ticks del kernel hace el resultado independiente de la velocidad del host en el
+ * port posix
+ */
+static void busyTicks(uint32_t ticks)
+{
+	uint32_t last = osGetTickCount();
+	uint32_t now;
+
+	while(ticks > 0)  {
+		now = osGetTickCount();
+		if(now != last)  {
+			ticks--;
+			last = now;
+		}
+	}
+}
+
+static void periodicBody(uint8_t index)
+{
+	task *self = periodicTask[index];
+
+	while(1)  {
+		busyTicks(periodicWcet[index]);
+		statsAdd(&stats, (uint32_t)(osGetTimeCycles() -
+				(uint64_t)self->releaseTick * portCyclesPerTick()));
+		osWaitNextPeriod();
+	}
+}
+
+static void periodicTask0(void) { periodicBody(0); }
+static void periodicTask1(void) { periodicBody(1); }
+static void periodicTask2(void) { periodicBody(2); }
+
+/*
+ * Tarea de mayor prioridad que termina la medición: despierta al final de los hiperperíodos,
+ * toma los resultados y elimina las tareas periódicas. Si el host pierde ciclos y el conjunto
+ * queda sobrecargado el runner no volvería a ejecutarse, por eso la medición la termina esta
+ * tarea. Con EDF se le asigna un deadline de 1 tick para que desaloje a las tareas periódicas
+ */
+static void periodicSupervisor(void)
+{
+	uint8_t i;
+#if JAMMOS_CPU_USAGE
+	cpuUsage usage;
+	uint8_t j;
+#endif
+
+	osSleepUntil(periodicEnd);
+
+	osEnterCritical();
+#if JAMMOS_CPU_USAGE
+	osGetCpuUsage(&usage);
+	for(j = 0; j < usage.quantity_task; j++)
+		for(i = 0; i < PERIODIC_TASKS; i++)
+			if(usage.id[j] == periodicTask[i]->id)
+				periodicUtil += usage.usage[j];
+#endif
+	for(i = 0; i < PERIODIC_TASKS; i++)  {
+		periodicMisses += periodicTask[i]->deadlineMisses;
+		osDeleteTask(periodicTask[i]);
+	}
+	osExitCritical();
+
+	osGiveSemaphore(&semDone);
+	osDeleteTask(NULL);
+}
+
+static void benchPeriodic(void)
+{
+	static void (* const entry[PERIODIC_TASKS])(void) = {periodicTask0, periodicTask1, periodicTask2};
+	task *supervisor;
+	uint8_t i;
+	char extra[40];
+#if JAMMOS_CPU_USAGE
+	cpuUsage usage;
+#endif
+
+	osInitSemaphore(&semDone);
+	statsReset(&stats);
+	periodicMisses = 0;
+	periodicUtil = 0;
+#if JAMMOS_CPU_USAGE
+	osGetCpuUsage(&usage);
+#endif
+
+	/*
+	 * Las tareas se crean dentro de una sección crítica para que todas tengan su primer
+	 * release en el mismo tick. Las prioridades siguen rate monotonic
+	 */
+	osEnterCritical();
+	periodicEnd = osGetTickCount() + 150 * BENCH_HYPERPERIODS;
+	supervisor = osCreateTask(periodicSupervisor, PRIORITY_MAX);
+	osSetTaskPeriod(supervisor, 0, 1);
+	for(i = 0; i < PERIODIC_TASKS; i++)  {
+		periodicTask[i] = osCreateTask(entry[i], PRIORITY_MAX + 1 + i);
+		osSetTaskPeriod(periodicTask[i], periodicPeriod[i], 0);
+	}
+	osExitCritical();
+
+	osTakeSemaphore(&semDone, OS_WAIT_FOREVER);
+
+#if JAMMOS_CPU_USAGE
+	snprintf(extra, sizeof(extra), " misses=%u util=%u", (unsigned)periodicMisses, (unsigned)periodicUtil);
+#else
+	snprintf(extra, sizeof(extra), " misses=%u", (unsigned)periodicMisses);
+#endif
+	statsPrint(JAMMOS_SCHED_EDF ? "periodic_edf" : "periodic_fp", extra, &stats);
+}
+
+/*==================[pipeline]===============================================*/
+
+/*
+ * Productor de baja prioridad: genera un elemento cada 200 us de CPU
+ */
+static void pipelineProducer(void)
+{
+	uint32_t item = 0;
+	uint32_t start;
+
+	while(1)  {
+		start = portGetCycles();
+		while(portGetCycles() - start < portCpuFrequency() / 5000)
+			;
+		osPutQueue(&benchQueue, &item, OS_WAIT_FOREVER);
+		item++;
+	}
+}
+
+static void pipelineConsumer(void)
+{
+	uint32_t item;
+
+	while(1)  {
+		osGetQueue(&benchQueue, &item, OS_WAIT_FOREVER);
+		queueReceived++;
+	}
+}
+
+/*
+ * Sin umbral el consumidor desaloja al productor en cada tick en que hay elementos; con umbral
+ * el productor continúa hasta llenar la cola y el consumidor procesa los elementos por lotes
+ */
+static void benchPipeline(bool threshold)
+{
+	task *producer;
+	task *consumer;
+	uint32_t switches;
+	uint32_t ticks;
+
+	osInitQueue(&benchQueue, sizeof(uint32_t));
+	queueReceived = 0;
+
+	osEnterCritical();
+	producer = osCreateTask(pipelineProducer, PRIORITY_MIN);
+	consumer = osCreateTask(pipelineConsumer, PRIORITY_HIGH);
+	if(threshold)
+		osSetTaskThreshold(producer, PRIORITY_HIGH);
+	switches = osGetContextSwitches();
+	ticks = osGetTickCount();
+	osExitCritical();
+
+	osDelay(PIPELINE_TICKS);
+
+	osEnterCritical();
+	switches = osGetContextSwitches() - switches;
+	ticks = osGetTickCount() - ticks;
+	osDeleteTask(producer);
+	osDeleteTask(consumer);
+	osExitCritical();
+
+	ratePrint(threshold ? "pipeline_switches_pt" : "pipeline_switches", "", switches,
+			(uint32_t)((uint64_t)switches * OS_TICK_HZ / ticks), false);
+}
+
+/*==================[seqvalue]===============================================*/
+
+static void benchSeqValue(void)
+{
+	uint8_t sample[SEQVALUE_SIZE] = {0};
+	uint32_t i;
+	uint32_t start;
+	char extra[16];
+
+	snprintf(extra, sizeof(extra), " size=%u", SEQVALUE_SIZE);
+
+	statsReset(&stats);
+	for(i = 0; i < BENCH_ITERATIONS; i++)  {
+		sample[0] = (uint8_t)i;
+		start = portGetCycles();
+		osWriteSeqValue(&benchValue, sample);
+		statsAdd(&stats, portGetCycles() - start);
+	}
+	statsPrint("seqvalue_write", extra, &stats);
+
+	statsReset(&stats);
+	for(i = 0; i < BENCH_ITERATIONS; i++)  {
+		start = portGetCycles();
+		osReadSeqValue(&benchValue, sample);
+		statsAdd(&stats, portGetCycles() - start);
+	}
+	statsPrint("seqvalue_read", extra, &stats);
+}
+
+/*==================[readers]================================================*/
+
+static void semReaderTask(void)
+{
+	while(1)  {
+		osTakeSemaphore(&semA, OS_WAIT_FOREVER);
+		osDelay(1);
+		osGiveSemaphore(&semA);
+		readsDone++;
+	}
+}
+
+static void rwLockReaderTask(void)
+{
+	while(1)  {
+		osReadLock(&benchLock, OS_WAIT_FOREVER);
+		osDelay(1);
+		osReadUnlock(&benchLock);
+		readsDone++;
+	}
+}
+
+/*
+ * Con el semáforo las lectoras se serializan y se completa una lectura por tick, con el lock
+ * de lectura/escritura se completan size lecturas por tick
+ */
+static void benchReaders(uint8_t readers, bool useRwLock)
+{
+	task *helper[DYNAMIC_TASK_NUMBER];
+	uint32_t ticks;
+	uint8_t j;
+	char extra[16];
+
+	osInitSemaphore(&semA);
+	osGiveSemaphore(&semA);
+	osInitRwLock(&benchLock);
+	readsDone = 0;
+
+	osEnterCritical();
+	for(j = 0; j < readers; j++)
+		helper[j] = osCreateTask(useRwLock ? rwLockReaderTask : semReaderTask, PRIORITY_HIGH);
+	ticks = osGetTickCount();
+	osExitCritical();
+
+	osDelay(READERS_TICKS);
+
+	osEnterCritical();
+	ticks = osGetTickCount() - ticks;
+	for(j = 0; j < readers; j++)
+		osDeleteTask(helper[j]);
+	osExitCritical();
+
+	snprintf(extra, sizeof(extra), " size=%u", readers);
+	ratePrint(useRwLock ? "readers_rwlock" : "readers_sem", extra, readsDone,
+			(uint32_t)((uint64_t)readsDone * OS_TICK_HZ / ticks), true);
+}
+
+#if JAMMOS_SCHED_TT
+/*==================[tt_dispatch]============================================*/
+
+static task *ttSlots[TT_FRAMES];
+static const ttSchedule ttTable = {TT_MINOR_TICKS, TT_FRAMES, ttSlots};
+
+/*
+ * Cada trabajo comienza en el tick de inicio de su marco, los ciclos desde ese tick son el costo
+ * del despacho en el SysTick más el cambio de contexto
+ */
+static void ttTask(void)
+{
+	while(1)  {
+		statsAdd(&stats, (uint32_t)(osGetTimeCycles() - osGetTickCount64() * portCyclesPerTick()));
+		osWaitNextFrame();
+	}
+}
+
+/*
+ * Tabla {A, B, A, libre}: el runner no está en la tabla y espera en el tiempo libre de los marcos
+ */
+static void benchTtDispatch(void)
+{
+	task *taskA;
+	task *taskB;
+	char extra[24];
+
+	statsReset(&stats);
+
+	osEnterCritical();
+	taskA = osCreateTask(ttTask, PRIORITY_HIGH);
+	taskB = osCreateTask(ttTask, PRIORITY_HIGH);
+	ttSlots[0] = taskA;
+	ttSlots[1] = taskB;
+	ttSlots[2] = taskA;
+	ttSlots[3] = NULL;
+	osSetScheduleTable(&ttTable);
+	osExitCritical();
+
+	osDelay(TT_TICKS);
+
+	osEnterCritical();
+	osSetScheduleTable(NULL);
+	snprintf(extra, sizeof(extra), " overruns=%u", (unsigned)osGetFrameOverruns());
+	osDeleteTask(taskA);
+	osDeleteTask(taskB);
+	osExitCritical();
+
+	statsPrint("tt_dispatch", extra, &stats);
+}
+#endif
+
+/*==================[runner]=================================================*/
+
+static void runnerTask(void)
+{
+	static const uint16_t queueSizes[] = {1, 4, 8, 16};
+	static const uint16_t streamChunks[] = {1, 16};
+	uint8_t i;
+
+	benchContextSwitch();
+	benchQueueSet();
+	benchSemPingPong();
+	for(i = 0; i < sizeof(queueSizes) / sizeof(queueSizes[0]); i++)
+		benchQueueSize(queueSizes[i]);
+	for(i = 0; i < sizeof(streamChunks) / sizeof(streamChunks[0]); i++)
+		benchStreamChunk(streamChunks[i]);
+	benchFanout(1, false);
+	benchFanout(1, true);
+	benchFanout(FANOUT_MAX, false);
+	benchFanout(FANOUT_MAX, true);
+	benchDelayWake();
+	benchTickHandler();
+	benchIrqLatency();
+	benchPeriodic();
+	benchPipeline(false);
+	benchPipeline(true);
+	benchSeqValue();
+	benchReaders(DYNAMIC_TASK_NUMBER, false);
+	benchReaders(DYNAMIC_TASK_NUMBER, true);
+#if JAMMOS_SCHED_TT
+	benchTtDispatch();
+#endif
+
+	printf("BENCH_DONE\n");
+	fflush(stdout);
+	exit(0);
+}
+
+int main(void)
+{
+	osInitTask(runnerTask, &runner, PRIORITY_RUNNER);
+	osInstallIRQ(BENCH_IRQ, benchIsr);
+
+	osInit();
+
+	while(1)  {
+	}
+
+	return 0;
+}
@@ -10,67 +10,128 @@
 
 #include <stdint.h>
 #include <stdbool.h>
-#include "board.h"
+#include "JAMMOS_PORT.h"
 
 /************************************************************************************
  * 			Tamaño del stack predefinido para cada tarea expresado en bytes
+ *
+ * 	El port puede redefinirlo, por ejemplo el port POSIX necesita stacks más grandes
  ***********************************************************************************/
 
+#ifndef STACK_SIZE
 #define STACK_SIZE 256
+#endif
+
+/*
+ * Los stacks de las tareas se guardan fuera de los TCB. OS_STACK_SECTION permite ubicarlos en
+ * una sección del linker, por ejemplo en un banco de SRAM distinto del de los datos del kernel.
+ * Los stacks de las tareas de OS_TASK_TABLE son datos inicializados si el port arma su contexto
+ * inicial al compilar, por lo que en ese caso la sección debe ser de datos y no NOLOAD
+ */
+#ifndef OS_STACK_SECTION
+#define OS_STACK_SECTION
+#endif
 
 //----------------------------------------------------------------------------------
 
 /************************************************************************************
- * 	Posiciones dentro del stack frame de los registros que conforman el stack frame
+ * 						Definiciones varias
  ***********************************************************************************/
+#define TASK_NAME_SIZE			10 //Tamaño máximo del vector del nombre de las tareas
+#ifndef MAX_TASK_NUMBER
+#define MAX_TASK_NUMBER			8  //número máximo de tareas en el OS (hasta 32, ver usedIds)
+#endif
+#define DYNAMIC_TASK_NUMBER		4  //número máximo de tareas creadas en tiempo de ejecución (osCreateTask)
 
-#define XPSR			1
-#define PC_REG			2
-#define LR				3
-#define R12				4
-#define R3				5
-#define R2				6
-#define R1				7
-#define R0				8
-#define LR_PREV_VALUE	9
-#define R4				10
-#define R5				11
-#define R6				12
-#define R7				13
-#define R8				14
-#define R9				15
-#define R10 			16
-#define R11 			17
+#define PRIORITY_MAX		0
+#ifndef PRIORITY_MIN
+#define PRIORITY_MIN		3
+#endif
 
-//----------------------------------------------------------------------------------
+#define PRIORITY_SIZE		(PRIORITY_MIN-PRIORITY_MAX) + 1
 
+#define OS_WAIT_FOREVER		0xFFFFFFFFUL	//timeout de las llamadas bloqueantes: espera sin límite
+#define OS_NO_WAIT			0				//timeout de las llamadas bloqueantes: no bloquea la tarea
 
-/************************************************************************************
- * 			Valores necesarios para registros del stack frame inicial
- ***********************************************************************************/
+#ifndef OS_TICK_HZ
+#define OS_TICK_HZ			1000	//frecuencia del tick de sistema, el port la configura en portInit
+#endif
 
-#define INIT_XPSR 	1 << 24				//xPSR.T = 1
-#define EXEC_RETURN	0xFFFFFFF9			//retornar a modo thread con MSP, FPU no utilizada
+/*
+ * Política de scheduling. Con 0 las tareas se eligen por prioridad fija con round robin entre
+ * tareas de igual prioridad. Con 1 las tareas periódicas (osSetTaskPeriod) se eligen por
+ * earliest deadline first y las tareas no periódicas se ejecutan por prioridad solo cuando
+ * ninguna tarea periódica está lista
+ */
+#ifndef JAMMOS_SCHED_EDF
+#define JAMMOS_SCHED_EDF	0
+#endif
 
-/************************************************************************************
- * 						Definiciones varias
- ***********************************************************************************/
-#define STACK_FRAME_SIZE	8
-#define FULL_REG_STACKING_SIZE 		17	//16 core registers + el valor del registro de Lr Previo link register
+/*
+ * Modo time-triggered (ejecutivo cíclico). Con 1, mientras hay una tabla instalada con
+ * osSetScheduleTable el SysTick despacha en cada marco menor la tarea indicada por la tabla,
+ * que tiene precedencia sobre cualquier otra política; las tareas que no están en la tabla se
+ * ejecutan por prioridad en el tiempo libre de cada marco, junto con la tarea idle
+ */
+#ifndef JAMMOS_SCHED_TT
+#define JAMMOS_SCHED_TT		0
+#endif
 
-#define TASK_NAME_SIZE			10 //Tamaño máximo del vector del nombre de las tareas
-#define MAX_TASK_NUMBER			8  //número máximo de tareas en el OS
+/*
+ * Ubicación de los caminos críticos del kernel en SRAM. Con 1, el código del cambio de contexto,
+ * del tick y del despacho de interrupciones (OS_RAMFUNC) y la estructura de control del OS
+ * (OS_RAMBSS) se ubican en las secciones que define el port (PORT_RAMFUNC y PORT_RAMBSS), que el
+ * arranque copia a una SRAM sin estados de espera. En un port sin esas secciones no tiene efecto
+ */
+#ifndef JAMMOS_RAMFUNC
+#define JAMMOS_RAMFUNC		0
+#endif
+
+#if JAMMOS_RAMFUNC && defined(PORT_RAMFUNC)
+#define OS_RAMFUNC			PORT_RAMFUNC
+#define OS_RAMBSS			PORT_RAMBSS
+#else
+#define OS_RAMFUNC
+#define OS_RAMBSS
+#endif
 
-#define PRIORITY_MAX		0
-#define PRIORITY_MIN		3
+/*
+ * Contabilidad del uso de CPU por tarea con el contador de ciclos del port (portGetCycles). Se
+ * acumulan los ciclos de cada tarea en cada cambio de contexto; poner en 0 para quitarla del OS
+ */
+#ifndef JAMMOS_CPU_USAGE
+#define JAMMOS_CPU_USAGE	1
+#endif
 
-#define PRIORITY_SIZE		(PRIORITY_MIN-PRIORITY_MAX) + 1
+#define CPU_USAGE_SCALE		10000	//el uso de CPU se expresa en centésimas de porcentaje
+
+/*
+ * Presupuestos de ejecución por tarea (osSetTaskBudget): el tiempo de CPU de cada tarea se
+ * descuenta en SysTick_Handler y en getNextContext con el contador de ciclos del port, y una
+ * tarea que agota su presupuesto se suspende hasta la reposición; poner en 0 para quitarlos
+ * del OS
+ */
+#ifndef JAMMOS_BUDGET
+#define JAMMOS_BUDGET		1
+#endif
+
+/*
+ * Estadísticas por interrupción (cantidad, duración y latencia en ciclos) medidas en
+ * osIrqHandler con el contador de ciclos del port; poner en 0 para quitarlas del OS
+ */
+#ifndef JAMMOS_IRQ_STATS
+#define JAMMOS_IRQ_STATS	1
+#endif
 
 /*==================[definicion codigos de error del sistema operativo]=================================*/
 
 #define ERR_OS_QUANTITY_TASK			-1
 #define ERR_OS_SCHEDULER				-2
 #define ERR_OS_PRIORITY_TOTAL_COUNT 	-3
+#define ERR_OS_BUDGET					-4
+#define ERR_OS_TT_TABLE					-5
+#define ERR_OS_TASK_TABLE				-6
+#define ERR_OS_TASK_STACK				-7
 
 /*==================[definicion de datos del sistema operativo]=================================*/
 
@@ -103,21 +164,111 @@ typedef enum _taskState taskState;
  * 			Definición de la estructura Tarea
  ***********************************************************************************/
 
+/*
+ * Los campos que leen el scheduler y el tick están al inicio y el stack está fuera de la
+ * estructura, así los TCB son compactos y contiguos
+ */
 struct _task{
-	uint32_t stack[STACK_SIZE/4];
-	uint32_t stack_pointer;
-	void *entry_point;
-	uint8_t id;
+	uintptr_t stack_pointer;
 	taskState state;
 	uint8_t priority;
+	uint8_t threshold;		//umbral de desalojo: en ejecución solo la desalojan tareas de prioridad mayor al umbral
+	uint8_t id;
+	bool sleeping;			//la tarea se encuentra en la lista de tareas dormidas
+	struct _task *nextSleep;//siguiente tarea en la lista de tareas dormidas (ordenada por wakeTick)
+	uint32_t wakeTick;		//tick absoluto en el que la tarea despierta de osDelay u osDelayUntil
+	struct _task **waitList;//lista de espera de la cola o semáforo en que espera la tarea, NULL si no espera
+	struct _task *nextWait;	//siguiente tarea en la lista de espera (ordenada por prioridad)
+	bool waitTimeout;		//la última espera terminó por timeout y no por el evento
+
+	uint32_t *stack;		//base del stack de la tarea (STACK_SIZE bytes)
+	void *entry_point;
 
-	uint32_t ticksWaiting; 	/*
-							 * Variable que lleva la cuenta de los ticks que la tarea lleva en conteo cuando
-	 	 	 	 	 	 	 * se llama a la función osDelay
-	 	 	 	 	 	 	 */
+	uint32_t period;		//período de la tarea periódica en ticks, 0 si la tarea no es periódica
+	uint32_t relDeadline;	//deadline relativo al release de cada trabajo en ticks
+	uint32_t releaseTick;	//tick de release del trabajo actual
+	uint32_t deadline;		//deadline absoluto del trabajo actual (releaseTick + relDeadline)
+	uint32_t deadlineMisses;//trabajos terminados luego de su deadline
+#if JAMMOS_SCHED_TT
+	bool ttWaiting;			//la tarea terminó el trabajo de su marco y espera el próximo (osWaitNextFrame)
+#endif
+#if JAMMOS_BUDGET
+	uint32_t budget;		//ciclos de CPU que puede ejecutar la tarea en cada período de reposición, 0 sin límite
+	uint32_t budgetPeriod;	//período de reposición del presupuesto en ticks
+	uint32_t budgetTick;	//tick de la próxima reposición del presupuesto
+	uint32_t budgetUsed;	//ciclos ejecutados en el período de reposición actual
+	uint32_t budgetMaxUsed;	//máximo de ciclos ejecutados en un período de reposición
+	uint32_t budgetOverruns;//cantidad de períodos en que la tarea agotó su presupuesto
+	bool budgetOverrun;		//la tarea agotó el presupuesto del período actual
+	bool budgetSuspended;	//la tarea está suspendida hasta la próxima reposición
+#endif
+#if JAMMOS_CPU_USAGE
+	uint32_t cpuCycles;		//ciclos de CPU ejecutados por la tarea desde la última medición
+#endif
+	PORT_TASK_FIELDS		//campos propios del port (por ejemplo el contexto en el port POSIX)
 };
 typedef struct _task task;
 
+/************************************************************************************
+ * 			Declaración estática de tareas
+ *
+ * 	OS_TASK_TABLE define las tareas, su contexto inicial y la tabla de tareas como datos
+ * 	inicializados, de forma que el arranque no arma los stack frames y los errores de
+ * 	configuración se detectan al compilar. Las tareas se listan con una macro que recibe
+ * 	a su vez la macro a aplicar a cada tarea (nombre, función y prioridad):
+ *
+ * 		#define APP_TASKS(TASK)				\
+ * 			TASK(taskA, taskAEntry, 0)		\
+ * 			TASK(taskB, taskBEntry, 1)
+ *
+ * 		OS_TASK_TABLE(appTasks, APP_TASKS);
+ *
+ * 	y la tabla se registra con osInitTaskTable(&appTasks) antes de osInit. Si el port no
+ * 	define PORT_STACK_STATIC_FRAME el contexto inicial se arma al registrar la tabla.
+ *
+ * 	Las tareas que se inicializan con osInitTask se declaran con OS_TASK, que define la
+ * 	tarea junto con su stack.
+ ***********************************************************************************/
+
+struct _taskTable {
+	task * const *tasks;					//tareas de la tabla, el índice es el id de la tarea
+	uint8_t quantity_task;					//cantidad de tareas de la tabla
+};
+
+typedef struct _taskTable taskTable;
+
+#ifdef PORT_STACK_STATIC_FRAME
+#define OS_STACK_FRAME(entry)				PORT_STACK_STATIC_FRAME(entry)
+#define OS_STACK_POINTER(stack)				PORT_STACK_STATIC_POINTER(stack)
+#else
+#define OS_STACK_FRAME(entry)				{ 0 }
+#define OS_STACK_POINTER(stack)				0
+#endif
+
+#define OS_TASK(name)																\
+	static uint32_t name##Stack[STACK_SIZE/4] OS_STACK_SECTION;						\
+	task name = { .stack = name##Stack }
+
+#define OS_TASK_ID_(name, entry, prio)		OS_TASK_ID_##name,
+#define OS_TASK_POINTER_(name, entry, prio)	&name,
+#define OS_TASK_CHECK_(name, entry, prio)											\
+	_Static_assert((prio) >= PRIORITY_MAX && (prio) <= PRIORITY_MIN,				\
+			"prioridad de la tarea " #name " fuera de rango");
+#define OS_TASK_DEFINE_(name, entry, prio)											\
+	static uint32_t name##Stack[STACK_SIZE/4] OS_STACK_SECTION = OS_STACK_FRAME(entry);	\
+	task name = { .stack_pointer = OS_STACK_POINTER(name##Stack), .state = READY,		\
+			.priority = (prio), .threshold = (prio), .id = OS_TASK_ID_##name,			\
+			.stack = name##Stack, .entry_point = (void *)(entry) };
+
+#define OS_TASK_TABLE(table, TASKS)													\
+	enum { TASKS(OS_TASK_ID_) table##Quantity };									\
+	_Static_assert(table##Quantity <= MAX_TASK_NUMBER,								\
+			"la tabla " #table " supera MAX_TASK_NUMBER");							\
+	TASKS(OS_TASK_CHECK_)															\
+	TASKS(OS_TASK_DEFINE_)															\
+	static task * const table##Tasks[] = { TASKS(OS_TASK_POINTER_) };				\
+	static const taskTable table = { table##Tasks, table##Quantity }
+
 /************************************************************************************
  * 			Definición de la estructura del sistema operativo
  ***********************************************************************************/
@@ -133,6 +284,7 @@ struct _osCrt{
 	task *next_task;				//variable que almacena el puntero de la tarea siguiente
 
 	bool contexSwitch;				//Bandera para realizar el cambio de contexto en el sistick
+	uint32_t contextSwitches;		//cantidad de cambios de contexto desde osInit
 
 	task *taskPriority[PRIORITY_SIZE][MAX_TASK_NUMBER]; /*Vector bidimencional que contiene la direcciones
 														 *de las tareas que tienen determinada prioridad
@@ -146,14 +298,93 @@ struct _osCrt{
 	uint8_t countCritical;
 
 	bool schedulingFromIRQ;
+
+	uint32_t usedIds;				//Mapa de bits de los id de tareas en uso, permite reciclar los id
+	task *deletedTask;				//Tarea dinámica que se eliminó a si misma y cuyo bloque se libera
+									//luego del cambio de contexto
+
+	uint64_t tickCount;				//cantidad de ticks de sistema desde osInit (no desborda)
+	task *sleepList;				//tareas dormidas ordenadas por tick de despertar, la primera es
+									//la próxima en despertar
+#if JAMMOS_SCHED_TT
+	const struct _ttSchedule *ttTable;	//tabla del ejecutivo cíclico, NULL si el modo no está activo
+	uint8_t ttFrame;				//próximo marco menor a despachar
+	uint32_t ttTicksLeft;			//ticks hasta el inicio del próximo marco menor
+	task *ttTask;					//tarea del marco menor actual, NULL si el marco es libre
+	uint32_t ttOverruns;			//marcos cuya tarea no terminó su trabajo antes del fin del marco
+#endif
+#if JAMMOS_BUDGET
+	uint8_t budgetTasks;			//cantidad de tareas con presupuesto de ejecución
+	uint32_t lastChargeCycles;		//contador de ciclos en el último descuento de presupuesto
+#endif
+#if JAMMOS_CPU_USAGE
+	uint32_t lastSwitchCycles;		//contador de ciclos en el último cambio de contexto
+	uint32_t windowStartCycles;		//contador de ciclos al inicio de la ventana de medición
+#endif
 };
 
 typedef struct _osCrt osCrt;
 
+/************************************************************************************
+ * 			Definición de la estructura con la medición de uso de CPU
+ ***********************************************************************************/
+
+struct _cpuUsage {
+	uint32_t windowCycles;					//ciclos totales de la ventana medida
+	uint8_t quantity_task;					//cantidad de tareas medidas
+	uint8_t id[MAX_TASK_NUMBER];			//id de cada tarea medida
+	uint16_t usage[MAX_TASK_NUMBER];		//uso de CPU de cada tarea en centésimas de porcentaje
+	uint16_t idle;							//uso de CPU de la tarea idle en centésimas de porcentaje
+};
+
+typedef struct _cpuUsage cpuUsage;
+
+/************************************************************************************
+ * 			Definición de la estructura con las estadísticas del presupuesto
+ ***********************************************************************************/
+
+struct _budgetStats {
+	uint32_t budgetCycles;					//presupuesto por período de reposición en ciclos
+	uint32_t usedCycles;					//ciclos ejecutados en el período actual
+	uint32_t maxUsedCycles;					//máximo de ciclos ejecutados en un período
+	uint32_t overruns;						//cantidad de períodos en que se agotó el presupuesto
+	bool suspended;							//la tarea está suspendida hasta la reposición
+};
+
+typedef struct _budgetStats budgetStats;
+
+/************************************************************************************
+ * 			Definición de la tabla del ejecutivo cíclico
+ *
+ * 	El marco mayor se divide en minorFrames marcos menores de minorTicks ticks y cada
+ * 	marco menor tiene asignada una tarea (o NULL para dejarlo libre). Una tarea puede
+ * 	aparecer en varios marcos para ejecutarse con una frecuencia múltiplo del marco mayor.
+ ***********************************************************************************/
+
+struct _ttSchedule {
+	uint32_t minorTicks;					//duración de cada marco menor en ticks
+	uint8_t minorFrames;					//cantidad de marcos menores del marco mayor
+	task * const *slots;					//tarea de cada marco menor, NULL para un marco libre
+};
+
+typedef struct _ttSchedule ttSchedule;
+
+/*
+ * Define en tiempo de compilación una tabla del ejecutivo cíclico con la lista de tareas de
+ * cada marco menor, por ejemplo OS_TT_SCHEDULE(table, 5, &taskA, &taskB, &taskA, NULL)
+ */
+#define OS_TT_SCHEDULE(name, minorTicks, ...)										\
+	static task * const name##Slots[] = { __VA_ARGS__ };							\
+	static const ttSchedule name = { (minorTicks),									\
+			(uint8_t)(sizeof(name##Slots) / sizeof(name##Slots[0])), name##Slots }
+
 /*==================[definicion de prototipos]=================================*/
 
 void osInitTask(void *entryPoint, task *task_init, uint8_t priority);
+void osInitTaskTable(const taskTable *table);
 void osInit(void);
+task* osCreateTask(void *entryPoint, uint8_t priority);
+bool osDeleteTask(task *task_delete);
 int32_t os_getError(void);
 task* getCurrentTask(void);
 void osForceSchCC(void);
@@ -167,4 +398,70 @@ void osSetSytemState(osState state);
 void osSetScheduleFromISR(bool value);
 bool osGetScheduleFromISR(void);
 
+bool osSetTaskThreshold(task *task_threshold, uint8_t threshold);
+uint32_t osGetContextSwitches(void);
+
+uint32_t osGetTickCount(void);
+uint64_t osGetTickCount64(void);
+uint64_t osGetTimeCycles(void);
+uint64_t osGetTimeNs(void);
+void osSleepUntil(uint32_t wakeTick);
+
+void osSetTaskPeriod(task *task_periodic, uint32_t period, uint32_t relDeadline);
+bool osWaitNextPeriod(void);
+
+#if JAMMOS_SCHED_TT
+void osSetScheduleTable(const ttSchedule *table);
+bool osWaitNextFrame(void);
+uint32_t osGetFrameOverruns(void);
+#endif
+
+bool osWaitEvent(task **waitList, uint32_t timeout);
+bool osSignalEvent(task **waitList);
+uint8_t osBroadcastEvent(task **waitList);
+
+#if JAMMOS_CPU_USAGE
+void osGetCpuUsage(cpuUsage *usage);
+#endif
+
+#if JAMMOS_BUDGET
+void osSetTaskBudget(task *task_budget, uint32_t budgetUs, uint32_t periodTicks);
+bool osGetBudgetStats(task *task_budget, budgetStats *stats);
+#endif
+
+/*==================[compilación de prueba]=================================*/
+
+/*
+ * En la compilación de prueba (JAMMOS_TEST, junto con el port port/test) las funciones
+ * internas del kernel son visibles para que un harness las llame directamente y controle
+ * el estado del OS sin ejecutar las tareas
+ */
+#ifdef JAMMOS_TEST
+#define OS_INTERNAL
+
+void scheduler(void);
+void initPriority(void);
+void osTestReset(void);
+osCrt* osTestGetControl(void);
+task* osTestGetIdleTask(void);
+#else
+#define OS_INTERNAL		static
+#endif
+
+/*==================[interfaz con el port]=================================*/
+
+/*
+ * Funciones que cada port (directorio port/<nombre>) debe implementar
+ */
+void portInit(void);
+void portInitTaskContext(task *task_init, void *entryPoint);
+
+/*
+ * Funciones del kernel que llama el port: el cambio de contexto (PendSV), el tick de sistema
+ * y el hook de retorno de tareas
+ */
+uintptr_t getNextContext(uintptr_t sp_current);
+void SysTick_Handler(void);
+void returnHook(void);
+
 #endif /* JAMMOS_H_ */
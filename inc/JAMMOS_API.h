@@ -32,12 +32,46 @@ typedef enum _semState semState;
  */
 
 struct _semaphore{
-	task* semaphoreTask;
+	task* waitList;				//tareas que esperan el semáforo, ordenadas por prioridad
 	semState state;
+	task** setWaitList;			//lista de espera del conjunto al que pertenece, o NULL
 };
 
 typedef struct _semaphore semaphore;
 
+/*
+ * Define un semáforo inicializado (tomado) como dato, sin llamar a osInitSemaphore
+ */
+#define OS_SEMAPHORE_STATIC(name)													\
+	semaphore name = { .waitList = NULL, .state = TAKEN, .setWaitList = NULL }
+
+/********************************************************************************
+ * Definicion de la estructura para los locks de lectura/escritura
+ *******************************************************************************/
+/**
+ *Definición de la estructura del lock de lectura/escritura
+ *
+ *Varias tareas lectoras pueden tener el lock a la vez, una escritora lo tiene en forma
+ *exclusiva. Las escritoras tienen preferencia: con una escritora esperando, las nuevas
+ *lectoras esperan. Al liberarse, el lock se entrega directamente a las tareas despertadas.
+ */
+
+struct _rwLock {
+	uint8_t readers;			//tareas lectoras que tienen el lock
+	bool writer;				//una tarea escritora tiene el lock
+	task* readWaitList;			//tareas lectoras que esperan, ordenadas por prioridad
+	task* writeWaitList;		//tareas escritoras que esperan, ordenadas por prioridad
+};
+
+typedef struct _rwLock rwLock;
+
+/*
+ * Define un lock de lectura/escritura libre como dato, sin llamar a osInitRwLock
+ */
+#define OS_RWLOCK_STATIC(name)														\
+	rwLock name = { .readers = 0, .writer = false, .readWaitList = NULL,			\
+			.writeWaitList = NULL }
+
 
 /********************************************************************************
  * Definicion de la estructura para las colas
@@ -52,19 +86,138 @@ struct _queue {
 	uint16_t size;				/*tamaño de los datos*/
 	uint16_t head;				/*índice del último elemento de la cola*/
 	uint16_t tail;				/*índice del primer elemento de la cola*/
-	task* queueTask;			/*tarea asociada a la cola*/
+	task* getWaitList;			/*tareas que esperan datos en la cola vacía*/
+	task* putWaitList;			/*tareas que esperan lugar en la cola llena*/
+	task** setWaitList;			/*lista de espera del conjunto al que pertenece, o NULL*/
 };
 
 typedef struct _queue queue;
 
+/*
+ * Define una cola vacía inicializada como dato, sin llamar a osInitQueue. El tamaño del
+ * elemento se verifica al compilar
+ */
+#define OS_QUEUE_STATIC(name, elementSize)											\
+	_Static_assert((elementSize) > 0 && (elementSize) <= QUEUE_SIZE,				\
+			"tamaño de elemento de la cola " #name " fuera de rango");				\
+	queue name = { .size = (elementSize), .head = 0, .tail = 0,						\
+			.getWaitList = NULL, .putWaitList = NULL, .setWaitList = NULL }
+
+/********************************************************************************
+ * Definicion de la estructura para los buffers de bytes y de mensajes
+ *******************************************************************************/
+/**
+ *Definición de la estructura del buffer de bytes
+ *
+ *A diferencia de la cola, el buffer copia bloques de largo variable en un solo llamado y la
+ *tarea lectora se despierta recién cuando hay triggerLevel bytes disponibles. El buffer de
+ *mensajes usa la misma estructura guardando cada mensaje precedido por su largo.
+ */
+
+struct _streamBuffer {
+
+	uint8_t *buffer;			/*Almacenamiento del buffer, provisto por la aplicación*/
+	uint16_t size;				/*tamaño del almacenamiento en bytes*/
+	uint16_t head;				/*índice donde se escribe el próximo byte*/
+	uint16_t tail;				/*índice del próximo byte a leer*/
+	uint16_t count;				/*bytes almacenados*/
+	uint16_t triggerLevel;		/*bytes necesarios para despertar a la tarea lectora*/
+	task* readWaitList;			/*tareas que esperan datos*/
+	task* writeWaitList;		/*tareas que esperan lugar*/
+	task** setWaitList;			/*lista de espera del conjunto al que pertenece, o NULL*/
+};
+
+typedef struct _streamBuffer streamBuffer;
+typedef struct _streamBuffer messageBuffer;
+
+/*
+ * Define un buffer de bytes vacío y su almacenamiento como datos, sin llamar a
+ * osInitStreamBuffer. El tamaño y el nivel de disparo se verifican al compilar
+ */
+#define OS_STREAM_BUFFER_STATIC(name, bytes, trigger)								\
+	_Static_assert((bytes) > 0 && (bytes) <= UINT16_MAX,							\
+			"tamaño del buffer " #name " fuera de rango");							\
+	_Static_assert((trigger) > 0 && (trigger) <= (bytes),							\
+			"nivel de disparo del buffer " #name " fuera de rango");				\
+	static uint8_t name##Storage[bytes];											\
+	streamBuffer name = { .buffer = name##Storage, .size = (bytes), .head = 0,		\
+			.tail = 0, .count = 0, .triggerLevel = (trigger),						\
+			.readWaitList = NULL, .writeWaitList = NULL, .setWaitList = NULL }
+
+/*
+ * Define un buffer de mensajes vacío y su almacenamiento como datos, sin llamar a
+ * osInitMessageBuffer. Cada mensaje ocupa su largo más MESSAGE_HEADER_SIZE bytes
+ */
+#define MESSAGE_HEADER_SIZE		sizeof(uint16_t)
+#define MESSAGE_DISCARDED		UINT16_MAX	//mensaje más largo que el destino de osReceiveMessage
+
+#define OS_MESSAGE_BUFFER_STATIC(name, bytes)										\
+	_Static_assert((bytes) > MESSAGE_HEADER_SIZE && (bytes) <= UINT16_MAX,			\
+			"tamaño del buffer de mensajes " #name " fuera de rango");				\
+	static uint8_t name##Storage[bytes];											\
+	messageBuffer name = { .buffer = name##Storage, .size = (bytes), .head = 0,		\
+			.tail = 0, .count = 0, .triggerLevel = 1,								\
+			.readWaitList = NULL, .writeWaitList = NULL, .setWaitList = NULL }
+
+/********************************************************************************
+ * Definicion de la estructura para los valores de última muestra
+ *******************************************************************************/
+/**
+ *Definición de la estructura del valor de última muestra
+ *
+ *Un único escritor, que puede ser una interrupción, publica muestras y las tareas lectoras
+ *obtienen siempre la última sin bloquear ni deshabilitar interrupciones. El escritor copia
+ *la muestra en el buffer que no está publicado y luego incrementa sequence, cuyo bit menos
+ *significativo indica el buffer publicado. La lectora repite la copia si sequence cambió
+ *mientras copiaba.
+ */
+
+struct _seqValue {
+
+	uint8_t *buffers;			/*Dos buffers de size bytes, provistos por la aplicación*/
+	uint16_t size;				/*tamaño de la muestra*/
+	volatile uint32_t sequence;	/*muestras publicadas, el bit 0 indica el buffer publicado*/
+};
+
+typedef struct _seqValue seqValue;
+
+/*
+ * Define un valor de última muestra sin muestras y sus buffers como datos, sin llamar a
+ * osInitSeqValue. El tamaño de la muestra se verifica al compilar
+ */
+#define OS_SEQVALUE_STATIC(name, elementSize)										\
+	_Static_assert((elementSize) > 0 && (elementSize) <= UINT16_MAX,				\
+			"tamaño de muestra de " #name " fuera de rango");						\
+	static uint8_t name##Buffers[2 * (elementSize)];								\
+	seqValue name = { .buffers = name##Buffers, .size = (elementSize), .sequence = 0 }
+
 void osDelay(uint32_t ticks);
+bool osDelayUntil(uint32_t *lastWakeTick, uint32_t period);
 
 void osInitSemaphore(semaphore *sem);
 void osGiveSemaphore(semaphore *sem);
-void osTakeSemaphore(semaphore *sem);
+bool osTakeSemaphore(semaphore *sem, uint32_t timeout);
+
+void osInitRwLock(rwLock *lock);
+bool osReadLock(rwLock *lock, uint32_t timeout);
+void osReadUnlock(rwLock *lock);
+bool osWriteLock(rwLock *lock, uint32_t timeout);
+void osWriteUnlock(rwLock *lock);
 
 void osInitQueue(queue *que, uint16_t size);
-void osPutQueue(queue *que, void* data);
-void osGetQueue(queue *que, void* data);
+bool osPutQueue(queue *que, void* data, uint32_t timeout);
+bool osGetQueue(queue *que, void* data, uint32_t timeout);
+
+void osInitStreamBuffer(streamBuffer *sb, uint8_t *buffer, uint16_t size, uint16_t triggerLevel);
+uint16_t osWriteStream(streamBuffer *sb, const void *data, uint16_t length, uint32_t timeout);
+uint16_t osReadStream(streamBuffer *sb, void *data, uint16_t length, uint32_t timeout);
+
+void osInitMessageBuffer(messageBuffer *mb, uint8_t *buffer, uint16_t size);
+bool osSendMessage(messageBuffer *mb, const void *message, uint16_t length, uint32_t timeout);
+uint16_t osReceiveMessage(messageBuffer *mb, void *message, uint16_t maxLength, uint32_t timeout);
+
+void osInitSeqValue(seqValue *sv, uint8_t *buffers, uint16_t size);
+void osWriteSeqValue(seqValue *sv, const void *data);
+uint32_t osReadSeqValue(const seqValue *sv, void *data);
 
 #endif /* PROJECTS_MSE_IOS1_JAMM_INC_JAMMOS_API_H_ */
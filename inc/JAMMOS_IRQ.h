@@ -10,14 +10,44 @@
 
 #include "JAMMOS.h"
 #include "JAMMOS_API.h"
-#include "board.h"
-#include "cmsis_43xx.h"
 
-#define IRQ_QUANTITY	53
+/*
+ * El tipo de número de interrupción (portIrqType) y la cantidad de interrupciones
+ * (PORT_IRQ_QUANTITY) los define el port
+ */
+#define IRQ_QUANTITY	PORT_IRQ_QUANTITY
 
 extern osCrt crt_OS;
 
-bool osInstallIRQ(LPC43XX_IRQn_Type irq, void* usrIsr);
-bool osRemoveIRQ(LPC43XX_IRQn_Type irq);
+/**
+ *Definición de la estructura con las estadísticas de una interrupción
+ */
+
+struct _irqStats {
+	uint32_t count;				/*cantidad de veces que se ejecutó la interrupción*/
+	uint32_t minCycles;			/*duración mínima del handler en ciclos*/
+	uint32_t avgCycles;			/*duración promedio del handler en ciclos*/
+	uint32_t maxCycles;			/*duración máxima del handler en ciclos*/
+	uint32_t minLatency;		/*latencia mínima desde la entrada al handler hasta la ISR de usuario*/
+	uint32_t avgLatency;		/*latencia promedio desde la entrada al handler hasta la ISR de usuario*/
+	uint32_t maxLatency;		/*latencia máxima desde la entrada al handler hasta la ISR de usuario*/
+	uint32_t scheduleCount;		/*cantidad de veces que la interrupción provocó un scheduling*/
+};
+
+typedef struct _irqStats irqStats;
+
+bool osInstallIRQ(portIrqType irq, void* usrIsr);
+bool osRemoveIRQ(portIrqType irq);
+
+#if JAMMOS_IRQ_STATS
+bool osGetIrqStats(portIrqType irq, irqStats *stats);
+void osResetIrqStats(void);
+#endif
+
+/*
+ * Handler común de las interrupciones del OS, lo llaman los handlers de la tabla de
+ * vectores del port
+ */
+void osIrqHandler(portIrqType irq);
 
 #endif /* PROJECTS_MSE_IOS1_JAMM_INC_JAMMOS_IRQ_H_ */
@@ -0,0 +1,89 @@
+/*
+ * JAMMOS_MEM.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#ifndef PROJECTS_MSE_IOS1_JAMM_INC_JAMMOS_MEM_H_
+#define PROJECTS_MSE_IOS1_JAMM_INC_JAMMOS_MEM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "JAMMOS.h"
+
+/*
+ * Tamaño real de un bloque: se redondea a múltiplo de 4 bytes para mantener la alineación
+ * de los bloques y se asegura que entre el puntero de la lista de bloques libres
+ */
+#define POOL_BLOCK_SIZE(size)	((((size) < sizeof(void*) ? sizeof(void*) : (size)) + 3) & ~3)
+
+/*
+ * Clases de tamaño del asignador osMemAlloc. Cada clase es un pool de bloques fijos, el pedido
+ * se atiende con la clase más chica que tenga bloques libres y alcance el tamaño pedido
+ */
+#define MEM_CLASS_QUANTITY	4
+
+#define MEM_CLASS_0_SIZE	16
+#define MEM_CLASS_0_COUNT	16
+#define MEM_CLASS_1_SIZE	32
+#define MEM_CLASS_1_COUNT	8
+#define MEM_CLASS_2_SIZE	64
+#define MEM_CLASS_2_COUNT	4
+#define MEM_CLASS_3_SIZE	128
+#define MEM_CLASS_3_COUNT	2
+
+/*
+ * Macro para declarar el buffer (alineado a palabra) de un pool de count bloques de size bytes
+ */
+#define OS_POOL_BUFFER(name, size, count)	static uint32_t name[(POOL_BLOCK_SIZE(size)/4)*(count)]
+
+/********************************************************************************
+ * Definicion de la estructura para los pools de bloques fijos
+ *******************************************************************************/
+/**
+ *Definición de la estructura del pool de memoria
+ */
+
+struct _memPool {
+	void *freeList;				/*lista enlazada de bloques libres*/
+	uint8_t *buffer;			/*inicio de la memoria del pool*/
+	uint32_t blockSize;			/*tamaño de cada bloque en bytes*/
+	uint16_t blockCount;		/*cantidad total de bloques*/
+	uint16_t freeCount;			/*cantidad de bloques libres*/
+	uint16_t minFree;			/*mínima cantidad de bloques libres alcanzada*/
+	uint32_t allocCount;		/*cantidad de asignaciones satisfechas*/
+	uint32_t failCount;			/*cantidad de asignaciones fallidas por pool vacío*/
+	uint32_t fallbackCount;		/*asignaciones de osMemAlloc entregadas por una clase mayor*/
+};
+
+typedef struct _memPool memPool;
+
+/**
+ *Definición de la estructura con las estadísticas de uso de un pool
+ */
+
+struct _memPoolStats {
+	uint32_t blockSize;
+	uint16_t blockCount;
+	uint16_t freeCount;
+	uint16_t minFree;
+	uint32_t allocCount;
+	uint32_t failCount;
+	uint32_t fallbackCount;
+};
+
+typedef struct _memPoolStats memPoolStats;
+
+void osInitPool(memPool *pool, void *buffer, uint32_t blockSize, uint16_t blockCount);
+void* osPoolAlloc(memPool *pool);
+void osPoolFree(memPool *pool, void *block);
+bool osPoolContains(memPool *pool, void *block);
+void osGetPoolStats(memPool *pool, memPoolStats *stats);
+
+void osInitMem(void);
+void* osMemAlloc(uint16_t size);
+void osMemFree(void *block);
+bool osGetMemStats(uint8_t memClassIndex, memPoolStats *stats);
+
+#endif /* PROJECTS_MSE_IOS1_JAMM_INC_JAMMOS_MEM_H_ */
@@ -0,0 +1,79 @@
+/*
+ * JAMMOS_PUBSUB.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#ifndef PROJECTS_MSE_IOS1_JAMM_INC_JAMMOS_PUBSUB_H_
+#define PROJECTS_MSE_IOS1_JAMM_INC_JAMMOS_PUBSUB_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "JAMMOS.h"
+
+/********************************************************************************
+ * Definicion de la estructura para los tópicos de publicación/suscripción
+ *******************************************************************************/
+/**
+ *Definición de la estructura del tópico
+ *
+ *Cada publicación se copia una sola vez en un anillo de depth ranuras compartido por todos
+ *los suscriptores, que la leen con su propio índice. El publicador nunca bloquea: si un
+ *suscriptor se atrasa más de depth publicaciones pierde las más viejas.
+ */
+
+struct _topic {
+
+	uint8_t *slots;				/*Ranuras de las publicaciones, provistas por la aplicación*/
+	uint16_t size;				/*tamaño de cada publicación*/
+	uint16_t depth;				/*cantidad de ranuras*/
+	uint16_t head;				/*ranura donde se escribe la próxima publicación*/
+	uint32_t published;			/*publicaciones realizadas desde la inicialización*/
+	task* waitList;				/*suscriptores que esperan una publicación*/
+	task** setWaitList;			/*lista de espera del conjunto al que pertenece, o NULL*/
+};
+
+typedef struct _topic topic;
+
+/**
+ *Definición de la estructura del suscriptor
+ */
+
+struct _subscriber {
+
+	topic *tp;					/*tópico al que está suscripto*/
+	uint32_t next;				/*número de la próxima publicación a leer*/
+	uint32_t lost;				/*publicaciones sobrescritas antes de ser leídas*/
+};
+
+typedef struct _subscriber subscriber;
+
+/*
+ * Define un tópico sin publicaciones y sus ranuras como datos, sin llamar a osInitTopic. El
+ * tamaño y la cantidad de ranuras se verifican al compilar
+ */
+#define OS_TOPIC_STATIC(name, elementSize, slotCount)								\
+	_Static_assert((elementSize) > 0 && (elementSize) <= UINT16_MAX,				\
+			"tamaño de publicación del tópico " #name " fuera de rango");			\
+	_Static_assert((slotCount) > 0 && (slotCount) <= UINT16_MAX,					\
+			"cantidad de ranuras del tópico " #name " fuera de rango");				\
+	static uint8_t name##Slots[(elementSize) * (slotCount)];						\
+	topic name = { .slots = name##Slots, .size = (elementSize),						\
+			.depth = (slotCount), .head = 0, .published = 0,						\
+			.waitList = NULL, .setWaitList = NULL }
+
+/*
+ * Define un suscriptor de un tópico definido con OS_TOPIC_STATIC, que recibe las
+ * publicaciones desde la primera
+ */
+#define OS_SUBSCRIBER_STATIC(name, topicName)										\
+	subscriber name = { .tp = &(topicName), .next = 0, .lost = 0 }
+
+void osInitTopic(topic *tp, uint8_t *slots, uint16_t size, uint16_t depth);
+void osSubscribe(subscriber *sub, topic *tp);
+void osPublish(topic *tp, const void *data);
+bool osReadTopic(subscriber *sub, void *data, uint32_t timeout);
+uint32_t osGetSubscriberLag(const subscriber *sub);
+
+#endif /* PROJECTS_MSE_IOS1_JAMM_INC_JAMMOS_PUBSUB_H_ */
@@ -0,0 +1,70 @@
+/*
+ * JAMMOS_SET.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#ifndef PROJECTS_MSE_IOS1_JAMM_INC_JAMMOS_SET_H_
+#define PROJECTS_MSE_IOS1_JAMM_INC_JAMMOS_SET_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "JAMMOS.h"
+#include "JAMMOS_API.h"
+#include "JAMMOS_PUBSUB.h"
+
+#define QUEUE_SET_SIZE		4	//número máximo de objetos en un conjunto
+
+/**
+ *Enumeración de los tipos de objeto que pueden formar parte de un conjunto
+ */
+
+enum _setMemberType {
+	SET_QUEUE,				//queue, listo con al menos un elemento
+	SET_SEMAPHORE,			//semaphore, listo si está liberado
+	SET_STREAM,				//streamBuffer o messageBuffer, listo al alcanzar el nivel de disparo
+	SET_SUBSCRIBER			//subscriber, listo con publicaciones sin leer
+};
+
+typedef enum _setMemberType setMemberType;
+
+/**
+ *Definición de un objeto del conjunto
+ */
+
+struct _setMember {
+	setMemberType type;
+	void *object;
+};
+
+typedef struct _setMember setMember;
+
+/********************************************************************************
+ * Definicion de la estructura para los conjuntos de espera
+ *******************************************************************************/
+/**
+ *Definición de la estructura del conjunto
+ *
+ *Una tarea espera en el conjunto hasta que alguno de sus objetos esté listo y luego lo lee
+ *con la API del objeto y timeout OS_NO_WAIT. Cada objeto guarda la lista de espera del
+ *conjunto, por lo que puede pertenecer a un solo conjunto.
+ */
+
+struct _queueSet {
+
+	setMember members[QUEUE_SET_SIZE];	/*Objetos del conjunto, en orden de preferencia*/
+	uint8_t quantity;					/*cantidad de objetos*/
+	task* waitList;						/*tareas que esperan algún objeto listo*/
+};
+
+typedef struct _queueSet queueSet;
+
+void osInitQueueSet(queueSet *set);
+bool osAddToQueueSet(queueSet *set, setMemberType type, void *object);
+bool osRemoveFromQueueSet(queueSet *set, void *object);
+void* osWaitQueueSet(queueSet *set, uint32_t timeout);
+
+bool osSignalSet(task **setWaitList);
+
+#endif /* PROJECTS_MSE_IOS1_JAMM_INC_JAMMOS_SET_H_ */
@@ -0,0 +1,86 @@
+/*
+ * JAMMOS_TRACE.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#ifndef PROJECTS_MSE_IOS1_JAMM_INC_JAMMOS_TRACE_H_
+#define PROJECTS_MSE_IOS1_JAMM_INC_JAMMOS_TRACE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "JAMMOS.h"
+
+/*
+ * Registro de eventos del kernel en un buffer circular en RAM. Se habilita en tiempo de
+ * compilación con JAMMOS_TRACE=1, deshabilitado las macros OS_TRACE no generan código
+ */
+#ifndef JAMMOS_TRACE
+#define JAMMOS_TRACE		0
+#endif
+
+#define TRACE_BUFFER_SIZE	256		//cantidad de eventos del buffer, debe ser potencia de 2
+
+#define TRACE_MAGIC			0x4352544A	//"JTRC" encabezado del volcado binario
+#define TRACE_VERSION		2		//versión 1: arg de 16 bits
+#define TRACE_NO_TASK		0xFE	//id de tarea registrado antes del primer cambio de contexto
+
+/************************************************************************************
+ * 			Definición de los eventos del registro
+ ***********************************************************************************/
+
+enum _traceEventId {
+	TRACE_TICK,				//tick de sistema
+	TRACE_SCHEDULE,			//decisión del scheduler, arg = id de la tarea siguiente
+	TRACE_SWITCH,			//cambio de contexto, arg = id de la tarea entrante
+	TRACE_IRQ_ENTER,		//entrada a osIrqHandler, arg = número de IRQ
+	TRACE_IRQ_EXIT,			//salida de osIrqHandler, arg = número de IRQ
+	TRACE_QUEUE_PUT,		//dato escrito en una cola, buffer o tópico, arg = dirección
+	TRACE_QUEUE_GET,		//dato leído de una cola, buffer o tópico, arg = dirección
+	TRACE_QUEUE_BLOCK,		//tarea bloqueada en una cola, buffer o tópico, arg = dirección
+	TRACE_SEM_GIVE,			//semáforo o rwLock liberado, arg = dirección
+	TRACE_SEM_TAKE,			//semáforo o rwLock tomado, arg = dirección
+	TRACE_SEM_BLOCK,		//tarea bloqueada en un semáforo o rwLock, arg = dirección
+	TRACE_DELAY,			//llamado a osDelay, arg = ticks
+	TRACE_TASK_CREATE,		//tarea creada, arg = id de la tarea
+	TRACE_TASK_DELETE,		//tarea eliminada, arg = id de la tarea
+	TRACE_TIMEOUT,			//venció el timeout de una espera, arg = dirección de la cola o semáforo
+	TRACE_USER				//primer id libre para eventos del usuario
+};
+
+typedef enum _traceEventId traceEventId;
+
+/**
+ *Definición de un evento registrado (12 bytes)
+ *
+ *El argumento es de 32 bits para que las direcciones de los objetos no se trunquen: en el
+ *LPC43xx objetos en distintos bancos de SRAM (0x1000xxxx y 0x1008xxxx) tendrían los mismos
+ *16 bits bajos y el decodificador no podría distinguirlos.
+ */
+
+struct _traceEvent {
+	uint32_t timestamp;		/*contador de ciclos del port al registrar el evento*/
+	uint32_t arg;			/*argumento del evento*/
+	uint8_t event;			/*identificador del evento (traceEventId)*/
+	uint8_t taskId;			/*id de la tarea en ejecución*/
+};
+
+typedef struct _traceEvent traceEvent;
+
+/*
+ * Función que envía un byte del volcado, por ejemplo uartWriteByte o fputc por semihosting
+ */
+typedef void (*tracePutByte)(uint8_t byte);
+
+#if JAMMOS_TRACE
+#define OS_TRACE(event, arg)	osTraceRecord((event), (uint32_t)(uintptr_t)(arg))
+#else
+#define OS_TRACE(event, arg)	((void)0)
+#endif
+
+void osTraceRecord(uint8_t event, uint32_t arg);
+void osTraceEnable(bool enable);
+void osTraceDump(tracePutByte putByte);
+
+#endif /* PROJECTS_MSE_IOS1_JAMM_INC_JAMMOS_TRACE_H_ */
@@ -0,0 +1,57 @@
+/*
+ * JAMMOS_WORK.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#ifndef PROJECTS_MSE_IOS1_JAMM_INC_JAMMOS_WORK_H_
+#define PROJECTS_MSE_IOS1_JAMM_INC_JAMMOS_WORK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "JAMMOS.h"
+
+#define WORK_QUEUE_SIZE		16	//número máximo de trabajos pendientes en cada cola de trabajo
+#define MAX_WORK_QUEUES		4	//número máximo de colas de trabajo (tareas worker) en el OS
+
+/**
+ *Definición del tipo de función que ejecuta un trabajo diferido
+ */
+
+typedef void (*workFunction)(void *arg);
+
+/**
+ *Definición de la estructura de un trabajo diferido (función + argumento)
+ */
+
+struct _workItem {
+	workFunction function;		/*función que ejecuta la tarea worker*/
+	void *arg;					/*argumento que recibe la función*/
+};
+
+typedef struct _workItem workItem;
+
+/********************************************************************************
+ * Definicion de la estructura para las colas de trabajo
+ *******************************************************************************/
+/**
+ *Definición de la estructura de la cola de trabajo
+ */
+
+struct _workQueue {
+
+	workItem items[WORK_QUEUE_SIZE];	/*Trabajos pendientes*/
+	uint16_t head;						/*índice donde se escribe el próximo trabajo*/
+	uint16_t tail;						/*índice del próximo trabajo a ejecutar*/
+	task* workerTask;					/*tarea worker que vacía la cola*/
+	task* waitList;						/*tarea worker cuando espera trabajo*/
+	uint32_t lostWork;					/*trabajos descartados por cola llena*/
+};
+
+typedef struct _workQueue workQueue;
+
+bool osInitWorkQueue(workQueue *wq, task *worker, uint8_t priority);
+bool osPostWork(workQueue *wq, workFunction function, void *arg);
+
+#endif /* PROJECTS_MSE_IOS1_JAMM_INC_JAMMOS_WORK_H_ */
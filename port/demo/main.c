@@ -0,0 +1,146 @@
+/*
+ * main.c
+ *
+ *  Aplicación de ejemplo de los ports de simulación de JAMMOS (posix y qemu_m3)
+ *
+ *  Una tarea productora dispara cada PRODUCER_PERIOD ticks una interrupción por software, cuya
+ *  ISR envía un contador por una cola, y una tarea consumidora lo imprime. Luego de
+ *  DEMO_MESSAGES mensajes una tarea de mayor prioridad imprime el uso de CPU y las
+ *  estadísticas de la interrupción, si están habilitadas, y termina el programa.
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "JAMMOS.h"
+#include "JAMMOS_API.h"
+#include "JAMMOS_IRQ.h"
+
+#define PRODUCER_PERIOD		100		//ticks
+#define DEMO_MESSAGES		10
+
+#ifndef DEMO_IRQ
+#define DEMO_IRQ			0		//línea de interrupción disparada por software
+#endif
+
+OS_QUEUE_STATIC(messageQueue, sizeof(uint32_t));
+static volatile uint32_t counter = 0;
+static volatile uint32_t received = 0;
+
+/*
+ * ISR de la interrupción disparada por la tarea productora
+ */
+static void demoIsr(void)
+{
+	uint32_t value = counter;
+
+	/*
+	 * Desde una interrupción la cola no bloquea, si despierta a la tarea consumidora el
+	 * scheduling se realiza a la salida del handler
+	 */
+	osPutQueue(&messageQueue, &value, OS_NO_WAIT);
+}
+
+/*
+ * Tarea periódica: osDelayUntil mantiene el período exacto sin acumular la deriva del
+ * tiempo de ejecución de la tarea
+ */
+static void producerTask(void)
+{
+	uint32_t lastWake = osGetTickCount();
+
+	while(1)  {
+		osDelayUntil(&lastWake, PRODUCER_PERIOD);
+		counter++;
+		portRaiseIrq(DEMO_IRQ);
+	}
+}
+
+/*
+ * Las funciones de libc no son reentrantes entre tareas, por lo que las impresiones se
+ * realizan dentro de una sección crítica
+ */
+static void consumerTask(void)
+{
+	uint32_t value;
+
+	while(1)  {
+		if(!osGetQueue(&messageQueue, &value, 2 * PRODUCER_PERIOD))  {
+			osEnterCritical();
+			printf("[%5u ticks] timeout esperando mensajes\n", (unsigned)osGetTickCount());
+			fflush(stdout);
+			osExitCritical();
+			continue;
+		}
+
+		osEnterCritical();
+		printf("[%5u ticks] mensaje %u\n", (unsigned)osGetTickCount(), (unsigned)value);
+		fflush(stdout);
+		osExitCritical();
+
+		received++;
+	}
+}
+
+static void monitorTask(void)
+{
+#if JAMMOS_CPU_USAGE
+	cpuUsage usage;
+	uint8_t i;
+#endif
+#if JAMMOS_IRQ_STATS
+	irqStats stats;
+#endif
+
+	while(received < DEMO_MESSAGES)
+		osDelay(PRODUCER_PERIOD);
+
+	osEnterCritical();
+#if JAMMOS_CPU_USAGE
+	osGetCpuUsage(&usage);
+	printf("uso de CPU en %u ciclos:\n", (unsigned)usage.windowCycles);
+	for(i = 0; i < usage.quantity_task; i++)
+		printf("  tarea %u: %u.%02u %%\n", usage.id[i], usage.usage[i] / 100, usage.usage[i] % 100);
+	printf("  idle: %u.%02u %%\n", usage.idle / 100, usage.idle % 100);
+#endif
+
+#if JAMMOS_IRQ_STATS
+	osGetIrqStats(DEMO_IRQ, &stats);
+	printf("irq %d: %u veces, duracion %u/%u/%u ciclos (min/avg/max)\n", (int)DEMO_IRQ,
+			(unsigned)stats.count, (unsigned)stats.minCycles, (unsigned)stats.avgCycles,
+			(unsigned)stats.maxCycles);
+#endif
+	fflush(stdout);
+	exit(0);
+}
+
+/*
+ * Las tareas se declaran como datos inicializados: en qemu_m3 también su contexto inicial, en
+ * posix el contexto se arma al registrar la tabla
+ */
+#define DEMO_TASKS(TASK)					\
+	TASK(producer, producerTask, 1)			\
+	TASK(consumer, consumerTask, 2)			\
+	TASK(monitor, monitorTask, 0)
+
+OS_TASK_TABLE(demoTasks, DEMO_TASKS);
+
+int main(void)
+{
+	osInitTaskTable(&demoTasks);
+
+	osInstallIRQ(DEMO_IRQ, demoIsr);
+
+	osInit();
+
+	/*
+	 * El primer tick realiza el cambio de contexto hacia la primera tarea, el contexto de
+	 * main no se vuelve a ejecutar
+	 */
+	while(1)  {
+	}
+
+	return 0;
+}
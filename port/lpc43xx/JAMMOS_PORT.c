@@ -0,0 +1,83 @@
+/*
+ * JAMMOS_PORT.c
+ *
+ *  Port de JAMMOS para el LPC4337 (Cortex-M4F) de la EDU-CIAA
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#include "JAMMOS.h"
+
+/*************************************************************************************************
+	 *  @brief Inicializa el hardware que necesita el OS.
+     *
+     *  @details
+     *   Todas las interrupciones tienen prioridad 0 (la maxima) al iniciar la ejecucion. Para que
+     *   no se de la condicion de fault mencionada en la teoria, debemos bajar la prioridad de
+     *   PendSV en el NVIC. La cuenta matematica que se observa da la probabilidad mas baja posible.
+     *   Luego se arranca el SysTick con período OS_TICK_HZ, la aplicación debe haber actualizado
+     *   SystemCoreClock (SystemCoreClockUpdate) antes de llamar a osInit.
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+void portInit(void)
+{
+	NVIC_SetPriority(PendSV_IRQn, (1 << __NVIC_PRIO_BITS)-1); // @suppress("Symbol is not resolved")
+	SysTick_Config(SystemCoreClock / OS_TICK_HZ);
+}
+
+/*************************************************************************************************
+	 *  @brief Habilita el contador de ciclos DWT CYCCNT.
+     *
+     *  @details
+     *   Es necesario habilitar primero el bloque de trace en el registro DEMCR.
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+void portInitCycleCounter(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/*************************************************************************************************
+	 *  @brief Construye el stack frame inicial de una tarea
+     *
+     *  @details
+     *   Carga en el stack de la tarea los registros que se recuperan en el primer cambio de
+     *   contexto hacia ella (PendSV_Handler) y actualiza el stack pointer de la tarea.
+     *
+	 *  @param *task_init			Puntero a la estructura de la tarea.
+	 *  @param *entryPoint			Puntero a la función asociada a la tarea.
+	 *  @return     None.
+***************************************************************************************************/
+void portInitTaskContext(task *task_init, void *entryPoint)
+{
+	/*
+	 * Se configura el bit thumb en uno para indicar que solo se trabaja con instrucciones thumb
+	 */
+	task_init->stack[STACK_SIZE/4 - XPSR] = INIT_XPSR;
+
+	/* Se inicializa el registro PC del stack de la tarea con la dirección de la función asociada
+	 * a la tarea, asignandole el parámetro (ENTRY_POINT)
+	 */
+	task_init->stack[STACK_SIZE/4 - PC_REG] = (uint32_t)entryPoint;
+
+	/* Se configura el registro Linker return al hook de retorno, En el caso de que alguna tarea
+	 *  retorne, no deberia pasar nunca, si pasa hay un error.
+	 */
+	task_init->stack[STACK_SIZE/4 - LR] = (uint32_t)returnHook;
+
+	/*
+	 * Se guarda en el stack el valor previo del LR ya que se necesita
+	 * porque el valor del LR en la interrupción de PendSV_Handler
+	 * cambia al llamar la función de cambio de contexto getContextoSiguiente
+	 */
+	task_init->stack[STACK_SIZE/4 - LR_PREV_VALUE] = EXEC_RETURN;
+
+	task_init->stack_pointer = (uintptr_t) (task_init->stack + STACK_SIZE/4 - FULL_REG_STACKING_SIZE);
+}
@@ -0,0 +1,200 @@
+/*
+ * JAMMOS_PORT.h
+ *
+ *  Port de JAMMOS para el LPC4337 (Cortex-M4F) de la EDU-CIAA
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#ifndef PROJECTS_MSE_IOS1_JAMM_PORT_LPC43XX_JAMMOS_PORT_H_
+#define PROJECTS_MSE_IOS1_JAMM_PORT_LPC43XX_JAMMOS_PORT_H_
+
+#include <stdint.h>
+#include "board.h"
+#include "cmsis_43xx.h"
+
+/************************************************************************************
+ * 	Posiciones dentro del stack frame de los registros que conforman el stack frame
+ ***********************************************************************************/
+
+#define XPSR			1
+#define PC_REG			2
+#define LR				3
+#define R12				4
+#define R3				5
+#define R2				6
+#define R1				7
+#define R0				8
+#define LR_PREV_VALUE	9
+#define R4				10
+#define R5				11
+#define R6				12
+#define R7				13
+#define R8				14
+#define R9				15
+#define R10 			16
+#define R11 			17
+
+//----------------------------------------------------------------------------------
+
+
+/************************************************************************************
+ * 			Valores necesarios para registros del stack frame inicial
+ ***********************************************************************************/
+
+#define INIT_XPSR 	1 << 24				//xPSR.T = 1
+#define EXEC_RETURN	0xFFFFFFF9			//retornar a modo thread con MSP, FPU no utilizada
+
+#define STACK_FRAME_SIZE	8
+#define FULL_REG_STACKING_SIZE 		17	//16 core registers + el valor del registro de Lr Previo link register
+
+/*
+ * Contexto inicial de una tarea como dato inicializado (OS_TASK_TABLE): el mismo stack frame
+ * que arma portInitTaskContext y el stack pointer que apunta a él
+ */
+#define PORT_STACK_STATIC_FRAME(entry)												\
+	{																				\
+		[STACK_SIZE/4 - XPSR] = INIT_XPSR,											\
+		[STACK_SIZE/4 - PC_REG] = (uint32_t)(entry),								\
+		[STACK_SIZE/4 - LR] = (uint32_t)returnHook,									\
+		[STACK_SIZE/4 - LR_PREV_VALUE] = EXEC_RETURN }
+#define PORT_STACK_STATIC_POINTER(stack)											\
+	((uintptr_t)&(stack)[STACK_SIZE/4 - FULL_REG_STACKING_SIZE])
+
+/*
+ * Los stacks de las tareas pueden ubicarse en otro banco de SRAM que los datos del kernel, así
+ * los accesos al stack y a los TCB usan puertos distintos de la matriz AHB. Con el linker
+ * administrado de LPCXpresso, por ejemplo:
+ *
+ * 	-DOS_STACK_SECTION='__attribute__((section(".data.$RamAHB32")))'
+ */
+
+/*
+ * Secciones de JAMMOS_RAMFUNC: el código se copia a la SRAM local (RamLoc32, sin estados de
+ * espera) junto con .data, como en el script de enlace del firmware de la EDU-CIAA, que incluye
+ * *(.ramfunc*) en la sección .data. Las llamadas entre flash y SRAM quedan fuera del alcance
+ * de BL y el linker agrega los veneers de salto largo
+ */
+#define PORT_RAMFUNC		__attribute__((section(".ramfunc.$RamLoc32")))
+#define PORT_RAMBSS			__attribute__((section(".bss.$RamLoc32")))
+
+/************************************************************************************
+ * 			Campos propios del port en la estructura task
+ *
+ * 	En Cortex-M todo el contexto de la tarea se guarda en su stack
+ ***********************************************************************************/
+
+#define PORT_TASK_FIELDS
+
+/************************************************************************************
+ * 			Primitivas del port
+ ***********************************************************************************/
+
+typedef uint32_t portIrqState;				//valor de PRIMASK guardado
+
+#define portDisableIrq()		__disable_irq()
+#define portEnableIrq()			__enable_irq()
+#define portIdleWait()			__WFI()
+#define portMemoryBarrier()		__DMB()		//objetos compartidos con interrupciones sin sección crítica
+
+/*
+ * Contador de ciclos del CPU (DWT CYCCNT) y su frecuencia
+ */
+#define portGetCycles()			(DWT->CYCCNT)
+#define portCpuFrequency()		(SystemCoreClock)
+
+/*************************************************************************************************
+	 *  @brief Deshabilita las interrupciones guardando el estado previo
+     *
+	 *  @param 		None
+	 *  @return     Valor de PRIMASK antes de deshabilitar las interrupciones
+***************************************************************************************************/
+static inline portIrqState portSaveAndDisableIrq(void)
+{
+	portIrqState primask = __get_PRIMASK();
+	__disable_irq();
+	return primask;
+}
+
+/*************************************************************************************************
+	 *  @brief Restaura el estado de las interrupciones guardado por portSaveAndDisableIrq
+     *
+	 *  @param 		state	Valor de PRIMASK a restaurar
+	 *  @return     None
+***************************************************************************************************/
+static inline void portRestoreIrq(portIrqState state)
+{
+	__set_PRIMASK(state);
+}
+
+/*************************************************************************************************
+	 *  @brief Pide un cambio de contexto
+     *
+     *  @details
+     *   Deja pendiente la excepción PendSV, en cuyo handler se realiza el cambio de contexto
+     *   cuando no haya otra interrupción de mayor prioridad en ejecución.
+     *
+	 *  @param 		None
+	 *  @return     None
+***************************************************************************************************/
+static inline void portTriggerContextSwitch(void)
+{
+	/**
+	 * Se setea el bit correspondiente a la excepcion PendSV
+	 */
+	SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+
+	/**
+	 * Instruction Synchronization Barrier; flushes the pipeline and ensures that
+	 * all previous instructions are completed before executing new instructions
+	 */
+	__ISB();
+
+	/**
+	 * Data Synchronization Barrier; ensures that all memory accesses are
+	 * completed before next instruction is executed
+	 */
+	__DSB();
+}
+
+void portInitCycleCounter(void);
+
+/*************************************************************************************************
+	 *  @brief Ciclos transcurridos desde el último tick atendido por el kernel
+     *
+     *  @details
+     *   Se obtiene de la cuenta descendente del SysTick. Si el SysTick desbordó y su
+     *   interrupción está pendiente se vuelve a leer la cuenta y se suma un período. Debe
+     *   llamarse con las interrupciones enmascaradas.
+     *
+	 *  @param 		None
+	 *  @return     Ciclos desde el último tick
+***************************************************************************************************/
+static inline uint32_t portGetTickCycles(void)
+{
+	uint32_t reload = SysTick->LOAD;
+	uint32_t elapsed = reload - SysTick->VAL;
+
+	if(SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+		elapsed = reload - SysTick->VAL + reload + 1;
+
+	return elapsed;
+}
+
+#define portCyclesPerTick()		(SysTick->LOAD + 1)
+
+/************************************************************************************
+ * 			Tabla de interrupciones del LPC43xx
+ ***********************************************************************************/
+
+typedef LPC43XX_IRQn_Type portIrqType;
+
+#define PORT_IRQ_QUANTITY			53
+
+#define portEnableIrqLine(irq)		NVIC_EnableIRQ(irq)
+#define portDisableIrqLine(irq)		NVIC_DisableIRQ(irq)
+#define portClearIrqLine(irq)		NVIC_ClearPendingIRQ(irq)
+#define portRaiseIrq(irq)			NVIC_SetPendingIRQ(irq)		//interrupción disparada por software
+
+#endif /* PROJECTS_MSE_IOS1_JAMM_PORT_LPC43XX_JAMMOS_PORT_H_ */
@@ -0,0 +1,64 @@
+/*
+ * JAMMOS_PORT_IRQ.c
+ *
+ *  Handlers de la tabla de vectores del LPC43xx, todos derivan en osIrqHandler. Con
+ *  JAMMOS_RAMFUNC se ubican en SRAM junto con osIrqHandler
+ *
+ *  Created on: 14 jun. 2020
+ *      Author: root
+ */
+
+#include "JAMMOS_IRQ.h"
+
+/*==================[interrupt service routines]=============================*/
+
+OS_RAMFUNC void DAC_IRQHandler(void){osIrqHandler(         DAC_IRQn         );}
+OS_RAMFUNC void M0APP_IRQHandler(void){osIrqHandler(       M0APP_IRQn       );}
+OS_RAMFUNC void DMA_IRQHandler(void){osIrqHandler(         DMA_IRQn         );}
+OS_RAMFUNC void FLASH_EEPROM_IRQHandler(void){osIrqHandler(RESERVED1_IRQn   );}
+OS_RAMFUNC void ETH_IRQHandler(void){osIrqHandler(         ETHERNET_IRQn    );}
+OS_RAMFUNC void SDIO_IRQHandler(void){osIrqHandler(        SDIO_IRQn        );}
+OS_RAMFUNC void LCD_IRQHandler(void){osIrqHandler(         LCD_IRQn         );}
+OS_RAMFUNC void USB0_IRQHandler(void){osIrqHandler(        USB0_IRQn        );}
+OS_RAMFUNC void USB1_IRQHandler(void){osIrqHandler(        USB1_IRQn        );}
+OS_RAMFUNC void SCT_IRQHandler(void){osIrqHandler(         SCT_IRQn         );}
+OS_RAMFUNC void RIT_IRQHandler(void){osIrqHandler(         RITIMER_IRQn     );}
+OS_RAMFUNC void TIMER0_IRQHandler(void){osIrqHandler(      TIMER0_IRQn      );}
+OS_RAMFUNC void TIMER1_IRQHandler(void){osIrqHandler(      TIMER1_IRQn      );}
+OS_RAMFUNC void TIMER2_IRQHandler(void){osIrqHandler(      TIMER2_IRQn      );}
+OS_RAMFUNC void TIMER3_IRQHandler(void){osIrqHandler(      TIMER3_IRQn      );}
+OS_RAMFUNC void MCPWM_IRQHandler(void){osIrqHandler(       MCPWM_IRQn       );}
+OS_RAMFUNC void ADC0_IRQHandler(void){osIrqHandler(        ADC0_IRQn        );}
+OS_RAMFUNC void I2C0_IRQHandler(void){osIrqHandler(        I2C0_IRQn        );}
+OS_RAMFUNC void SPI_IRQHandler(void){osIrqHandler(         I2C1_IRQn        );}
+OS_RAMFUNC void I2C1_IRQHandler(void){osIrqHandler(        SPI_INT_IRQn     );}
+OS_RAMFUNC void ADC1_IRQHandler(void){osIrqHandler(        ADC1_IRQn        );}
+OS_RAMFUNC void SSP0_IRQHandler(void){osIrqHandler(        SSP0_IRQn        );}
+OS_RAMFUNC void SSP1_IRQHandler(void){osIrqHandler(        SSP1_IRQn        );}
+OS_RAMFUNC void UART0_IRQHandler(void){osIrqHandler(       USART0_IRQn      );}
+OS_RAMFUNC void UART1_IRQHandler(void){osIrqHandler(       UART1_IRQn       );}
+OS_RAMFUNC void UART2_IRQHandler(void){osIrqHandler(       USART2_IRQn      );}
+OS_RAMFUNC void UART3_IRQHandler(void){osIrqHandler(       USART3_IRQn      );}
+OS_RAMFUNC void I2S0_IRQHandler(void){osIrqHandler(        I2S0_IRQn        );}
+OS_RAMFUNC void I2S1_IRQHandler(void){osIrqHandler(        I2S1_IRQn        );}
+OS_RAMFUNC void SPIFI_IRQHandler(void){osIrqHandler(       RESERVED4_IRQn   );}
+OS_RAMFUNC void SGPIO_IRQHandler(void){osIrqHandler(       SGPIO_INT_IRQn   );}
+OS_RAMFUNC void GPIO0_IRQHandler(void){osIrqHandler(       PIN_INT0_IRQn    );}
+OS_RAMFUNC void GPIO1_IRQHandler(void){osIrqHandler(       PIN_INT1_IRQn    );}
+OS_RAMFUNC void GPIO2_IRQHandler(void){osIrqHandler(       PIN_INT2_IRQn    );}
+OS_RAMFUNC void GPIO3_IRQHandler(void){osIrqHandler(       PIN_INT3_IRQn    );}
+OS_RAMFUNC void GPIO4_IRQHandler(void){osIrqHandler(       PIN_INT4_IRQn    );}
+OS_RAMFUNC void GPIO5_IRQHandler(void){osIrqHandler(       PIN_INT5_IRQn    );}
+OS_RAMFUNC void GPIO6_IRQHandler(void){osIrqHandler(       PIN_INT6_IRQn    );}
+OS_RAMFUNC void GPIO7_IRQHandler(void){osIrqHandler(       PIN_INT7_IRQn    );}
+OS_RAMFUNC void GINT0_IRQHandler(void){osIrqHandler(       GINT0_IRQn       );}
+OS_RAMFUNC void GINT1_IRQHandler(void){osIrqHandler(       GINT1_IRQn       );}
+OS_RAMFUNC void EVRT_IRQHandler(void){osIrqHandler(        EVENTROUTER_IRQn );}
+OS_RAMFUNC void CAN1_IRQHandler(void){osIrqHandler(        C_CAN1_IRQn      );}
+OS_RAMFUNC void ADCHS_IRQHandler(void){osIrqHandler(       ADCHS_IRQn       );}
+OS_RAMFUNC void ATIMER_IRQHandler(void){osIrqHandler(      ATIMER_IRQn      );}
+OS_RAMFUNC void RTC_IRQHandler(void){osIrqHandler(         RTC_IRQn         );}
+OS_RAMFUNC void WDT_IRQHandler(void){osIrqHandler(         WWDT_IRQn        );}
+OS_RAMFUNC void M0SUB_IRQHandler(void){osIrqHandler(       M0SUB_IRQn       );}
+OS_RAMFUNC void CAN0_IRQHandler(void){osIrqHandler(        C_CAN0_IRQn      );}
+OS_RAMFUNC void QEI_IRQHandler(void){osIrqHandler(         QEI_IRQn         );}
@@ -0,0 +1,435 @@
+/*
+ * JAMMOS_PORT.c
+ *
+ *  Port de JAMMOS para ejecutar el kernel como un proceso de Linux (simulación en el host)
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#include "JAMMOS.h"
+#include "JAMMOS_IRQ.h"
+#include <errno.h>
+#include <stdbool.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+static volatile sig_atomic_t handlerNesting = 0;	//mayor a cero dentro del handler de una señal
+static volatile bool switchPending = false;			//cambio de contexto pendiente (PendSV simulado)
+static volatile bool irqDisabled = false;			//señales bloqueadas por una sección crítica
+static ucontext_t resetContext;						//contexto de main, se abandona en el primer cambio de contexto
+static volatile uint32_t enabledLines = 0;			//mapa de bits de las interrupciones simuladas habilitadas
+static volatile uint32_t pendingLines = 0;			//mapa de bits de las interrupciones simuladas pendientes
+static volatile uint32_t lastTickCycles = 0;		//contador de ciclos en el último tick atendido
+
+static void portSignalSet(sigset_t *set);
+static void taskTrampoline(void);
+static void contextSwitch(void);
+static void sysTickSignal(int sig);
+static void irqSignal(int sig);
+static void signalExit(void);
+
+/*************************************************************************************************
+	 *  @brief Inicializa el port POSIX.
+     *
+     *  @details
+     *   Instala los handlers de SIGALRM, que simula la interrupción de SysTick, y de SIGUSR1,
+     *   que simula las interrupciones de periféricos. Luego arranca el timer ITIMER_REAL con
+     *   período PORT_TICK_US. Se llama al final de osInit, a partir de este
+     *   punto el primer tick realiza el primer cambio de contexto.
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+void portInit(void)
+{
+	struct sigaction action;
+	struct itimerval timer;
+
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = sysTickSignal;
+	portSignalSet(&action.sa_mask);
+	action.sa_flags = SA_RESTART;
+	sigaction(SIGALRM, &action, NULL);
+
+	action.sa_handler = irqSignal;
+	sigaction(SIGUSR1, &action, NULL);
+
+	lastTickCycles = portGetCycles();
+
+	timer.it_interval.tv_sec = PORT_TICK_US / 1000000;
+	timer.it_interval.tv_usec = PORT_TICK_US % 1000000;
+	timer.it_value = timer.it_interval;
+	setitimer(ITIMER_REAL, &timer, NULL);
+}
+
+/*************************************************************************************************
+	 *  @brief Construye el contexto inicial de una tarea
+     *
+     *  @details
+     *   Crea un ucontext que ejecuta la tarea sobre su propio stack, con las señales del port
+     *   habilitadas. El stack_pointer de la tarea apunta a su contexto.
+     *
+	 *  @param *task_init			Puntero a la estructura de la tarea.
+	 *  @param *entryPoint			Puntero a la función asociada a la tarea.
+	 *  @return     None.
+***************************************************************************************************/
+void portInitTaskContext(task *task_init, void *entryPoint)
+{
+	(void)entryPoint;	//la función de la tarea se obtiene de entry_point al arrancar la tarea
+
+	getcontext(&task_init->context);
+	task_init->context.uc_stack.ss_sp = task_init->stack;
+	task_init->context.uc_stack.ss_size = STACK_SIZE;
+	task_init->context.uc_link = NULL;
+	sigemptyset(&task_init->context.uc_sigmask);
+	makecontext(&task_init->context, taskTrampoline, 0);
+
+	task_init->stack_pointer = (uintptr_t) &task_init->context;
+}
+
+/*************************************************************************************************
+	 *  @brief Deshabilita las interrupciones simuladas (bloquea las señales del port)
+     *
+     *  @details
+     *   Dentro del handler de una señal las señales ya están bloqueadas y la máscara la
+     *   restaura el retorno del handler, por lo que no se modifica.
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+void portDisableIrq(void)
+{
+	sigset_t set;
+
+	if(handlerNesting == 0)  {
+		portSignalSet(&set);
+		sigprocmask(SIG_BLOCK, &set, NULL);
+		irqDisabled = true;
+	}
+}
+
+/*************************************************************************************************
+	 *  @brief Habilita las interrupciones simuladas
+     *
+     *  @details
+     *   Si durante la sección crítica se pidió un cambio de contexto se realiza en este punto,
+     *   igual que la excepción PendSV pendiente se toma al habilitar las interrupciones.
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+void portEnableIrq(void)
+{
+	sigset_t set;
+
+	if(handlerNesting == 0)  {
+		irqDisabled = false;
+		portSignalSet(&set);
+		sigprocmask(SIG_UNBLOCK, &set, NULL);
+		if(switchPending)
+			portTriggerContextSwitch();
+	}
+}
+
+/*************************************************************************************************
+	 *  @brief Bloquea las señales del port guardando la máscara previa
+     *
+	 *  @param 		None.
+	 *  @return     Máscara de señales previa.
+***************************************************************************************************/
+portIrqState portSaveAndDisableIrq(void)
+{
+	sigset_t set;
+	portIrqState state;
+
+	portSignalSet(&set);
+	sigprocmask(SIG_BLOCK, &set, &state);
+	return state;
+}
+
+/*************************************************************************************************
+	 *  @brief Restaura la máscara de señales guardada por portSaveAndDisableIrq
+     *
+	 *  @param 		state	Máscara de señales a restaurar.
+	 *  @return     None.
+***************************************************************************************************/
+void portRestoreIrq(portIrqState state)
+{
+	sigprocmask(SIG_SETMASK, &state, NULL);
+}
+
+/*************************************************************************************************
+	 *  @brief Espera la próxima interrupción (equivalente a WFI)
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+void portIdleWait(void)
+{
+	pause();
+}
+
+/*************************************************************************************************
+	 *  @brief Pide un cambio de contexto (PendSV simulado)
+     *
+     *  @details
+     *   Desde el handler de una señal o con las interrupciones deshabilitadas el cambio queda
+     *   pendiente hasta la salida del handler o hasta portEnableIrq. Desde una tarea con las
+     *   interrupciones habilitadas se realiza inmediatamente con las señales bloqueadas.
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+void portTriggerContextSwitch(void)
+{
+	sigset_t set;
+	sigset_t previous;
+
+	switchPending = true;
+
+	if(handlerNesting == 0 && !irqDisabled)  {
+		portSignalSet(&set);
+		sigprocmask(SIG_BLOCK, &set, &previous);
+		if(switchPending)  {
+			switchPending = false;
+			contextSwitch();
+		}
+		sigprocmask(SIG_SETMASK, &previous, NULL);
+	}
+}
+
+/*************************************************************************************************
+	 *  @brief Habilita el contador de ciclos (no requiere inicialización en el host)
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+void portInitCycleCounter(void)
+{
+}
+
+/*************************************************************************************************
+	 *  @brief Contador de ciclos del port POSIX
+     *
+     *  @details
+     *   Devuelve los 32 bits bajos del tiempo de CLOCK_MONOTONIC en nanosegundos, de esta forma
+     *   se comporta como DWT CYCCNT con un CPU de 1 GHz.
+     *
+	 *  @param 		None.
+	 *  @return     Nanosegundos (módulo 2^32).
+***************************************************************************************************/
+uint32_t portGetCycles(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint32_t)((uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec);
+}
+
+/*************************************************************************************************
+	 *  @brief Ciclos (nanosegundos) transcurridos desde el último tick atendido por el kernel
+     *
+     *  @details
+     *   Si la señal del tick está bloqueada el valor puede superar un período, igual que en
+     *   Cortex-M con la interrupción de SysTick pendiente.
+     *
+	 *  @param 		None.
+	 *  @return     Nanosegundos desde el último tick.
+***************************************************************************************************/
+uint32_t portGetTickCycles(void)
+{
+	return portGetCycles() - lastTickCycles;
+}
+
+/*************************************************************************************************
+	 *  @brief Habilita una línea de interrupción simulada
+     *
+     *  @details
+     *   Si la línea quedó pendiente mientras estaba deshabilitada se atiende en este punto.
+     *
+	 *  @param 		irq		Número de interrupción.
+	 *  @return     None.
+***************************************************************************************************/
+void portEnableIrqLine(portIrqType irq)
+{
+	__atomic_or_fetch(&enabledLines, 1u << irq, __ATOMIC_SEQ_CST);
+
+	if(pendingLines & (1u << irq))
+		kill(getpid(), SIGUSR1);
+}
+
+/*************************************************************************************************
+	 *  @brief Deshabilita una línea de interrupción simulada
+     *
+	 *  @param 		irq		Número de interrupción.
+	 *  @return     None.
+***************************************************************************************************/
+void portDisableIrqLine(portIrqType irq)
+{
+	__atomic_and_fetch(&enabledLines, ~(1u << irq), __ATOMIC_SEQ_CST);
+}
+
+/*************************************************************************************************
+	 *  @brief Borra el pendiente de una línea de interrupción simulada
+     *
+	 *  @param 		irq		Número de interrupción.
+	 *  @return     None.
+***************************************************************************************************/
+void portClearIrqLine(portIrqType irq)
+{
+	__atomic_and_fetch(&pendingLines, ~(1u << irq), __ATOMIC_SEQ_CST);
+}
+
+/*************************************************************************************************
+	 *  @brief Dispara una interrupción simulada
+     *
+     *  @details
+     *   Deja la línea pendiente y envía SIGUSR1 al proceso. Puede llamarse desde tareas, desde
+     *   handlers y desde otros hilos del proceso (por ejemplo un hilo que lee la entrada
+     *   estándar), estos hilos deben bloquear SIGALRM y SIGUSR1 para que las señales se
+     *   atiendan siempre en el hilo del kernel.
+     *
+	 *  @param 		irq		Número de interrupción.
+	 *  @return     None.
+***************************************************************************************************/
+void portRaiseIrq(portIrqType irq)
+{
+	if(irq < 0 || irq >= PORT_IRQ_QUANTITY)
+		return;
+
+	__atomic_or_fetch(&pendingLines, 1u << irq, __ATOMIC_SEQ_CST);
+	kill(getpid(), SIGUSR1);
+}
+
+/*************************************************************************************************
+	 *  @brief Conjunto de señales que simulan interrupciones
+     *
+	 *  @param 		set		Conjunto donde se cargan las señales.
+	 *  @return     None.
+***************************************************************************************************/
+static void portSignalSet(sigset_t *set)
+{
+	sigemptyset(set);
+	sigaddset(set, SIGALRM);
+	sigaddset(set, SIGUSR1);
+}
+
+/*************************************************************************************************
+	 *  @brief Punto de entrada común de las tareas
+     *
+     *  @details
+     *   Llama a la función de la tarea actual. Si la tarea retorna se llama al hook de retorno,
+     *   igual que el LR inicial del stack frame en Cortex-M.
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+static void taskTrampoline(void)
+{
+	void (*entryPoint)(void) = (void (*)(void)) getCurrentTask()->entry_point;
+
+	entryPoint();
+	returnHook();
+}
+
+/*************************************************************************************************
+	 *  @brief Realiza el cambio de contexto (equivalente a PendSV_Handler)
+     *
+     *  @details
+     *   Obtiene del kernel, con getNextContext, el contexto de la tarea siguiente y guarda el
+     *   contexto actual. En el primer cambio de contexto se guarda el contexto de main, que no
+     *   se vuelve a utilizar. Debe llamarse con las señales del port bloqueadas.
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+static void contextSwitch(void)
+{
+	ucontext_t *current;
+	ucontext_t *next;
+
+	if(osGetSytemState() == FROM_RESET)
+		current = &resetContext;
+	else
+		current = (ucontext_t*) getCurrentTask()->stack_pointer;
+
+	next = (ucontext_t*) getNextContext((uintptr_t) current);
+
+	if(next != current)
+		swapcontext(current, next);
+}
+
+/*************************************************************************************************
+	 *  @brief Handler de SIGALRM (SysTick simulado)
+     *
+     *  @details
+     *   Llama al handler de SysTick del kernel, el cambio de contexto pedido por el scheduler
+     *   se realiza a la salida del handler.
+     *
+	 *  @param 		sig		Número de señal.
+	 *  @return     None.
+***************************************************************************************************/
+static void sysTickSignal(int sig)
+{
+	int savedErrno = errno;
+
+	(void)sig;
+
+	handlerNesting++;
+	lastTickCycles = portGetCycles();
+	SysTick_Handler();
+	signalExit();
+
+	errno = savedErrno;
+}
+
+/*************************************************************************************************
+	 *  @brief Handler de SIGUSR1 (interrupciones de periféricos simuladas)
+     *
+     *  @details
+     *   Atiende con osIrqHandler, de menor a mayor número, todas las líneas pendientes y
+     *   habilitadas. Igual que en el NVIC el pendiente se borra al entrar a la interrupción.
+     *
+	 *  @param 		sig		Número de señal.
+	 *  @return     None.
+***************************************************************************************************/
+static void irqSignal(int sig)
+{
+	int savedErrno = errno;
+	uint32_t lines;
+	portIrqType irq;
+
+	(void)sig;
+
+	handlerNesting++;
+	while((lines = pendingLines & enabledLines) != 0)  {
+		irq = __builtin_ctz(lines);
+		portClearIrqLine(irq);
+		osIrqHandler(irq);
+	}
+	signalExit();
+
+	errno = savedErrno;
+}
+
+/*************************************************************************************************
+	 *  @brief Salida común de los handlers de señales
+     *
+     *  @details
+     *   Si durante el handler se pidió un cambio de contexto se realiza en este punto, igual
+     *   que PendSV se ejecuta luego de las demás interrupciones por tener la prioridad más baja.
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+static void signalExit(void)
+{
+	handlerNesting--;
+
+	if(handlerNesting == 0 && switchPending)  {
+		switchPending = false;
+		contextSwitch();
+	}
+}
@@ -0,0 +1,87 @@
+/*
+ * JAMMOS_PORT.h
+ *
+ *  Port de JAMMOS para ejecutar el kernel como un proceso de Linux (simulación en el host)
+ *
+ *  Cada tarea tiene su propio contexto ucontext. El SysTick se simula con el timer ITIMER_REAL
+ *  (señal SIGALRM), las interrupciones de periféricos con SIGUSR1 y la excepción PendSV con un
+ *  cambio de contexto diferido hasta la salida del handler de la señal. Las secciones críticas
+ *  bloquean las señales del port.
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#ifndef PROJECTS_MSE_IOS1_JAMM_PORT_POSIX_JAMMOS_PORT_H_
+#define PROJECTS_MSE_IOS1_JAMM_PORT_POSIX_JAMMOS_PORT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <signal.h>
+#include <ucontext.h>
+
+/*
+ * Las funciones de libc y los handlers de señales del host necesitan stacks mucho más
+ * grandes que los de Cortex-M
+ */
+#define STACK_SIZE			(64 * 1024)
+
+#define PORT_TICK_US		(1000000 / OS_TICK_HZ)	//período del tick simulado en microsegundos
+
+/************************************************************************************
+ * 			Campos propios del port en la estructura task
+ *
+ * 	El contexto de la tarea se guarda en un ucontext_t, el stack_pointer de la tarea
+ * 	apunta a este contexto
+ ***********************************************************************************/
+
+#define PORT_TASK_FIELDS	ucontext_t context;
+
+/************************************************************************************
+ * 			Primitivas del port
+ ***********************************************************************************/
+
+typedef sigset_t portIrqState;				//máscara de señales guardada
+
+void portDisableIrq(void);
+void portEnableIrq(void);
+portIrqState portSaveAndDisableIrq(void);
+void portRestoreIrq(portIrqState state);
+void portIdleWait(void);
+void portTriggerContextSwitch(void);
+void portInitCycleCounter(void);
+uint32_t portGetCycles(void);
+
+/*
+ * Las interrupciones simuladas son handlers de señales del mismo hilo, alcanza con impedir que
+ * el compilador reordene los accesos
+ */
+#define portMemoryBarrier()		__atomic_signal_fence(__ATOMIC_SEQ_CST)
+
+/*
+ * El contador de ciclos del port POSIX cuenta nanosegundos de CLOCK_MONOTONIC
+ */
+#define portCpuFrequency()		(1000000000UL)
+
+uint32_t portGetTickCycles(void);
+#define portCyclesPerTick()		(PORT_TICK_US * 1000UL)
+
+/************************************************************************************
+ * 			Interrupciones simuladas
+ *
+ * 	Las líneas de interrupción se disparan por software con portRaiseIrq, que deja la
+ * 	línea pendiente y envía SIGUSR1 al proceso. El handler de SIGUSR1 atiende las líneas
+ * 	pendientes y habilitadas con osIrqHandler, de la misma forma que el NVIC.
+ ***********************************************************************************/
+
+typedef int portIrqType;
+
+#define PORT_IRQ_QUANTITY			8
+
+void portEnableIrqLine(portIrqType irq);
+void portDisableIrqLine(portIrqType irq);
+void portClearIrqLine(portIrqType irq);
+void portRaiseIrq(portIrqType irq);
+
+#endif /* PROJECTS_MSE_IOS1_JAMM_PORT_POSIX_JAMMOS_PORT_H_ */
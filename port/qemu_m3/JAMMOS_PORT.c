@@ -0,0 +1,102 @@
+/*
+ * JAMMOS_PORT.c
+ *
+ *  Port de JAMMOS para Cortex-M3 sobre QEMU (máquina lm3s6965evb)
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#include "JAMMOS.h"
+#include "JAMMOS_IRQ.h"
+
+static volatile uint32_t portTicks = 0;		//cantidad de desbordes del SysTick
+
+/*************************************************************************************************
+	 *  @brief Inicializa el hardware que necesita el OS.
+     *
+     *  @details
+     *   Baja la prioridad de PendSV al mínimo para que el cambio de contexto se realice luego
+     *   de cualquier otra interrupción y arranca el SysTick con período OS_TICK_HZ tomando como
+     *   fuente el reloj del CPU.
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+void portInit(void)
+{
+	SCB_SHPR3 |= 0xFFu << 16;	//prioridad de PendSV
+
+	SYST_RVR = PORT_CPU_HZ / OS_TICK_HZ - 1;
+	SYST_CVR = 0;
+	SYST_CSR = SYST_CSR_CLKSOURCE | SYST_CSR_TICKINT | SYST_CSR_ENABLE;
+}
+
+/*************************************************************************************************
+	 *  @brief Construye el stack frame inicial de una tarea
+     *
+     *  @details
+     *   Carga en el stack de la tarea los registros que se recuperan en el primer cambio de
+     *   contexto hacia ella (PendSV_Handler) y actualiza el stack pointer de la tarea.
+     *
+	 *  @param *task_init			Puntero a la estructura de la tarea.
+	 *  @param *entryPoint			Puntero a la función asociada a la tarea.
+	 *  @return     None.
+***************************************************************************************************/
+void portInitTaskContext(task *task_init, void *entryPoint)
+{
+	task_init->stack[STACK_SIZE/4 - XPSR] = INIT_XPSR;
+	task_init->stack[STACK_SIZE/4 - PC_REG] = (uint32_t)entryPoint;
+	task_init->stack[STACK_SIZE/4 - LR] = (uint32_t)returnHook;
+	task_init->stack[STACK_SIZE/4 - LR_PREV_VALUE] = EXEC_RETURN;
+
+	task_init->stack_pointer = (uintptr_t) (task_init->stack + STACK_SIZE/4 - FULL_REG_STACKING_SIZE);
+}
+
+/*************************************************************************************************
+	 *  @brief Habilita el contador de ciclos (el SysTick ya cuenta ciclos del CPU)
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+void portInitCycleCounter(void)
+{
+}
+
+/*************************************************************************************************
+	 *  @brief Contador de ciclos del CPU
+     *
+     *  @details
+     *   Se calcula con la cantidad de desbordes del SysTick y los ciclos dentro del tick
+     *   actual (portGetTickCycles).
+     *
+	 *  @param 		None.
+	 *  @return     Ciclos del CPU desde el arranque del SysTick (módulo 2^32).
+***************************************************************************************************/
+OS_RAMFUNC uint32_t portGetCycles(void)
+{
+	portIrqState irqState;
+	uint32_t cycles;
+
+	irqState = portSaveAndDisableIrq();
+	cycles = portTicks * portCyclesPerTick() + portGetTickCycles();
+	portRestoreIrq(irqState);
+
+	return cycles;
+}
+
+/*************************************************************************************************
+	 *  @brief Handler de SysTick del port
+     *
+     *  @details
+     *   Lleva la cuenta de desbordes que utiliza portGetCycles y llama al handler de SysTick
+     *   del kernel.
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+OS_RAMFUNC void portSysTickHandler(void)
+{
+	portTicks++;
+	SysTick_Handler();
+}
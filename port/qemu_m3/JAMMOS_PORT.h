@@ -0,0 +1,180 @@
+/*
+ * JAMMOS_PORT.h
+ *
+ *  Port de JAMMOS para Cortex-M3 sobre QEMU (máquina lm3s6965evb)
+ *
+ *  No depende de CMSIS ni de la biblioteca del fabricante: los pocos registros del core que
+ *  utiliza el OS (SCB, SysTick y NVIC) se definen en este archivo. QEMU no implementa el
+ *  contador DWT CYCCNT, por lo que el contador de ciclos se obtiene del SysTick.
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#ifndef PROJECTS_MSE_IOS1_JAMM_PORT_QEMU_M3_JAMMOS_PORT_H_
+#define PROJECTS_MSE_IOS1_JAMM_PORT_QEMU_M3_JAMMOS_PORT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Las tareas de la demo utilizan printf de newlib (semihosting), que necesita más stack
+ * que el predeterminado del OS
+ */
+#ifndef STACK_SIZE
+#define STACK_SIZE			1024
+#endif
+
+#ifndef PORT_CPU_HZ
+#define PORT_CPU_HZ			12000000	//oscilador interno del lm3s6965 luego del reset
+#endif
+
+/************************************************************************************
+ * 			Registros del core utilizados por el port
+ ***********************************************************************************/
+
+#define PORT_REG(address)		(*(volatile uint32_t *)(address))
+
+#define SCB_ICSR				PORT_REG(0xE000ED04)
+#define SCB_SHPR3				PORT_REG(0xE000ED20)
+#define SYST_CSR				PORT_REG(0xE000E010)
+#define SYST_RVR				PORT_REG(0xE000E014)
+#define SYST_CVR				PORT_REG(0xE000E018)
+#define NVIC_ISER0				PORT_REG(0xE000E100)
+#define NVIC_ICER0				PORT_REG(0xE000E180)
+#define NVIC_ISPR0				PORT_REG(0xE000E200)
+#define NVIC_ICPR0				PORT_REG(0xE000E280)
+
+#define ICSR_PENDSVSET			(1u << 28)
+#define ICSR_PENDSTSET			(1u << 26)
+#define SYST_CSR_ENABLE			(1u << 0)
+#define SYST_CSR_TICKINT		(1u << 1)
+#define SYST_CSR_CLKSOURCE		(1u << 2)
+
+/************************************************************************************
+ * 	Posiciones dentro del stack frame de los registros que conforman el stack frame
+ ***********************************************************************************/
+
+#define XPSR			1
+#define PC_REG			2
+#define LR				3
+#define R12				4
+#define R3				5
+#define R2				6
+#define R1				7
+#define R0				8
+#define LR_PREV_VALUE	9
+#define R4				10
+#define R5				11
+#define R6				12
+#define R7				13
+#define R8				14
+#define R9				15
+#define R10 			16
+#define R11 			17
+
+/************************************************************************************
+ * 			Valores necesarios para registros del stack frame inicial
+ ***********************************************************************************/
+
+#define INIT_XPSR 	1 << 24				//xPSR.T = 1
+#define EXEC_RETURN	0xFFFFFFF9			//retornar a modo thread con MSP
+
+#define STACK_FRAME_SIZE	8
+#define FULL_REG_STACKING_SIZE 		17	//16 core registers + el valor del registro de Lr Previo link register
+
+/*
+ * Contexto inicial de una tarea como dato inicializado (OS_TASK_TABLE): el mismo stack frame
+ * que arma portInitTaskContext y el stack pointer que apunta a él
+ */
+#define PORT_STACK_STATIC_FRAME(entry)												\
+	{																				\
+		[STACK_SIZE/4 - XPSR] = INIT_XPSR,											\
+		[STACK_SIZE/4 - PC_REG] = (uint32_t)(entry),								\
+		[STACK_SIZE/4 - LR] = (uint32_t)returnHook,									\
+		[STACK_SIZE/4 - LR_PREV_VALUE] = EXEC_RETURN }
+#define PORT_STACK_STATIC_POINTER(stack)											\
+	((uintptr_t)&(stack)[STACK_SIZE/4 - FULL_REG_STACKING_SIZE])
+
+/*
+ * Secciones de JAMMOS_RAMFUNC: el script de enlace ubica .ramfunc* en la sección .data, que
+ * Reset_Handler copia a la RAM. QEMU no simula estados de espera de la flash, por lo que aquí
+ * solo sirve para verificar la ubicación y los veneers de salto largo que agrega el linker
+ */
+#define PORT_RAMFUNC		__attribute__((section(".ramfunc")))
+#define PORT_RAMBSS
+
+/************************************************************************************
+ * 			Campos propios del port en la estructura task
+ ***********************************************************************************/
+
+#define PORT_TASK_FIELDS
+
+/************************************************************************************
+ * 			Primitivas del port
+ ***********************************************************************************/
+
+typedef uint32_t portIrqState;				//valor de PRIMASK guardado
+
+#define portDisableIrq()		__asm volatile("cpsid i" ::: "memory")
+#define portEnableIrq()			__asm volatile("cpsie i" ::: "memory")
+#define portIdleWait()			__asm volatile("wfi")
+#define portMemoryBarrier()		__asm volatile("dmb" ::: "memory")
+#define portCpuFrequency()		(PORT_CPU_HZ)
+
+static inline portIrqState portSaveAndDisableIrq(void)
+{
+	portIrqState primask;
+
+	__asm volatile("mrs %0, primask\n\tcpsid i" : "=r" (primask) :: "memory");
+	return primask;
+}
+
+static inline void portRestoreIrq(portIrqState state)
+{
+	__asm volatile("msr primask, %0" :: "r" (state) : "memory");
+}
+
+static inline void portTriggerContextSwitch(void)
+{
+	SCB_ICSR = ICSR_PENDSVSET;
+	__asm volatile("dsb\n\tisb" ::: "memory");
+}
+
+void portInitCycleCounter(void);
+uint32_t portGetCycles(void);
+
+/*
+ * Ciclos transcurridos desde el último tick atendido por el kernel, si el SysTick desbordó y
+ * su interrupción está pendiente se suma un período. Debe llamarse con las interrupciones
+ * enmascaradas
+ */
+static inline uint32_t portGetTickCycles(void)
+{
+	uint32_t reload = SYST_RVR;
+	uint32_t elapsed = reload - SYST_CVR;
+
+	if(SCB_ICSR & ICSR_PENDSTSET)
+		elapsed = reload - SYST_CVR + reload + 1;
+
+	return elapsed;
+}
+
+#define portCyclesPerTick()		(SYST_RVR + 1)
+
+/************************************************************************************
+ * 			Tabla de interrupciones
+ *
+ * 	Se atienden las 32 primeras interrupciones externas (un solo registro del NVIC)
+ ***********************************************************************************/
+
+typedef int portIrqType;
+
+#define PORT_IRQ_QUANTITY			32
+
+#define portEnableIrqLine(irq)		(NVIC_ISER0 = 1u << (irq))
+#define portDisableIrqLine(irq)		(NVIC_ICER0 = 1u << (irq))
+#define portClearIrqLine(irq)		(NVIC_ICPR0 = 1u << (irq))
+#define portRaiseIrq(irq)			(NVIC_ISPR0 = 1u << (irq))		//interrupción disparada por software
+
+#endif /* PROJECTS_MSE_IOS1_JAMM_PORT_QEMU_M3_JAMMOS_PORT_H_ */
@@ -0,0 +1,96 @@
+/*
+ * startup_lm3s6965.c
+ *
+ *  Tabla de vectores y código de arranque del port qemu_m3
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#include "JAMMOS.h"
+#include "JAMMOS_IRQ.h"
+
+extern uint32_t _etext, _sdata, _edata, _sbss, _ebss, _estack;
+
+extern int main(void);
+extern void initialise_monitor_handles(void);
+extern void __libc_init_array(void);
+extern void PendSV_Handler(void);
+extern void portSysTickHandler(void);
+
+void Reset_Handler(void);
+static void faultHandler(void);
+
+/*
+ * Handlers de las interrupciones externas, todos derivan en osIrqHandler
+ */
+#define IRQ_HANDLER(n)	OS_RAMFUNC static void irq##n##Handler(void) {osIrqHandler(n);}
+
+IRQ_HANDLER(0)  IRQ_HANDLER(1)  IRQ_HANDLER(2)  IRQ_HANDLER(3)
+IRQ_HANDLER(4)  IRQ_HANDLER(5)  IRQ_HANDLER(6)  IRQ_HANDLER(7)
+IRQ_HANDLER(8)  IRQ_HANDLER(9)  IRQ_HANDLER(10) IRQ_HANDLER(11)
+IRQ_HANDLER(12) IRQ_HANDLER(13) IRQ_HANDLER(14) IRQ_HANDLER(15)
+IRQ_HANDLER(16) IRQ_HANDLER(17) IRQ_HANDLER(18) IRQ_HANDLER(19)
+IRQ_HANDLER(20) IRQ_HANDLER(21) IRQ_HANDLER(22) IRQ_HANDLER(23)
+IRQ_HANDLER(24) IRQ_HANDLER(25) IRQ_HANDLER(26) IRQ_HANDLER(27)
+IRQ_HANDLER(28) IRQ_HANDLER(29) IRQ_HANDLER(30) IRQ_HANDLER(31)
+
+__attribute__((section(".isr_vector"), used))
+static void (* const vectorTable[16 + PORT_IRQ_QUANTITY])(void) = {
+	(void (*)(void)) &_estack,
+	Reset_Handler,
+	faultHandler,			//NMI
+	faultHandler,			//HardFault
+	faultHandler,			//MemManage
+	faultHandler,			//BusFault
+	faultHandler,			//UsageFault
+	0, 0, 0, 0,
+	faultHandler,			//SVCall
+	faultHandler,			//DebugMonitor
+	0,
+	PendSV_Handler,
+	portSysTickHandler,
+
+	irq0Handler,  irq1Handler,  irq2Handler,  irq3Handler,
+	irq4Handler,  irq5Handler,  irq6Handler,  irq7Handler,
+	irq8Handler,  irq9Handler,  irq10Handler, irq11Handler,
+	irq12Handler, irq13Handler, irq14Handler, irq15Handler,
+	irq16Handler, irq17Handler, irq18Handler, irq19Handler,
+	irq20Handler, irq21Handler, irq22Handler, irq23Handler,
+	irq24Handler, irq25Handler, irq26Handler, irq27Handler,
+	irq28Handler, irq29Handler, irq30Handler, irq31Handler
+};
+
+/*************************************************************************************************
+	 *  @brief Handler de reset
+     *
+     *  @details
+     *   Copia la sección .data desde flash, borra .bss, inicializa newlib (semihosting y
+     *   constructores) y llama a main.
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+void Reset_Handler(void)
+{
+	uint32_t *src = &_etext;
+	uint32_t *dst;
+
+	for(dst = &_sdata; dst < &_edata; )
+		*dst++ = *src++;
+
+	for(dst = &_sbss; dst < &_ebss; )
+		*dst++ = 0;
+
+	initialise_monitor_handles();
+	__libc_init_array();
+
+	main();
+
+	while(1);
+}
+
+static void faultHandler(void)
+{
+	while(1);
+}
@@ -0,0 +1,199 @@
+/*
+ * JAMMOS_PORT.c
+ *
+ *  Port de prueba de JAMMOS
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#include "JAMMOS.h"
+#include "JAMMOS_IRQ.h"
+
+static bool switchPending = false;			//PendSV pendiente
+static uint32_t irqDisabled = 0;			//profundidad de deshabilitación de interrupciones
+static uint32_t cycles = 0;					//contador de ciclos simulado
+static uint32_t enabledLines = 0;			//mapa de bits de las interrupciones habilitadas
+static uint32_t pendingLines = 0;			//mapa de bits de las interrupciones pendientes
+static uint32_t tickCycles = 0;				//ciclos dentro del tick actual
+static uint32_t (*cycleSource)(void) = NULL;	//reloj del host que reemplaza al contador, o NULL
+
+void portInit(void)
+{
+	switchPending = false;
+	irqDisabled = 0;
+	pendingLines = 0;
+}
+
+/*
+ * Las tareas no se ejecutan, el stack_pointer identifica a la tarea
+ */
+void portInitTaskContext(task *task_init, void *entryPoint)
+{
+	(void)entryPoint;
+	task_init->stack_pointer = (uintptr_t) task_init;
+}
+
+/*
+ * La deshabilitación de interrupciones se cuenta para que el harness verifique que las
+ * secciones críticas quedan balanceadas
+ */
+void portDisableIrq(void)
+{
+	irqDisabled++;
+}
+
+void portEnableIrq(void)
+{
+	if(irqDisabled > 0)
+		irqDisabled--;
+}
+
+portIrqState portSaveAndDisableIrq(void)
+{
+	return irqDisabled++;
+}
+
+void portRestoreIrq(portIrqState state)
+{
+	irqDisabled = state;
+}
+
+void portIdleWait(void)
+{
+}
+
+void portTriggerContextSwitch(void)
+{
+	switchPending = true;
+}
+
+void portInitCycleCounter(void)
+{
+	cycles = 0;
+}
+
+uint32_t portGetCycles(void)
+{
+	return cycleSource != NULL ? cycleSource() : cycles;
+}
+
+/*
+ * Los ciclos dentro del tick los fija el harness y se reinician en cada tick
+ */
+uint32_t portGetTickCycles(void)
+{
+	return tickCycles;
+}
+
+void portEnableIrqLine(portIrqType irq)
+{
+	enabledLines |= 1u << irq;
+}
+
+void portDisableIrqLine(portIrqType irq)
+{
+	enabledLines &= ~(1u << irq);
+}
+
+void portClearIrqLine(portIrqType irq)
+{
+	pendingLines &= ~(1u << irq);
+}
+
+void portRaiseIrq(portIrqType irq)
+{
+	pendingLines |= 1u << irq;
+}
+
+/*************************************************************************************************
+	 *  @brief Ejecuta un tick de sistema
+     *
+     *  @details
+     *   Llama al handler de SysTick del kernel y, si este pidió un cambio de contexto, lo
+     *   realiza igual que PendSV a la salida de la interrupción.
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+void portTestTick(void)
+{
+	tickCycles = 0;
+	SysTick_Handler();
+	portTestPendSV();
+}
+
+/*************************************************************************************************
+	 *  @brief Realiza el cambio de contexto pendiente
+     *
+     *  @details
+     *   Llama a getNextContext con el stack_pointer de la tarea actual, que pasa a ser la tarea
+     *   elegida por el scheduler (osTestGetControl()->current_task).
+     *
+	 *  @param 		None.
+	 *  @return     true si había un cambio de contexto pendiente.
+***************************************************************************************************/
+bool portTestPendSV(void)
+{
+	task *current;
+
+	if(!switchPending)
+		return false;
+
+	switchPending = false;
+	current = getCurrentTask();
+	getNextContext(current != NULL ? current->stack_pointer : 0);
+	return true;
+}
+
+/*************************************************************************************************
+	 *  @brief Atiende las interrupciones pendientes y habilitadas
+     *
+     *  @details
+     *   Las atiende de menor a mayor número con osIrqHandler y luego realiza el cambio de
+     *   contexto que hayan pedido.
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+void portTestRunIrqs(void)
+{
+	uint32_t lines;
+	portIrqType irq;
+
+	while((lines = pendingLines & enabledLines) != 0)  {
+		irq = __builtin_ctz(lines);
+		portClearIrqLine(irq);
+		osIrqHandler(irq);
+	}
+	portTestPendSV();
+}
+
+bool portTestSwitchPending(void)
+{
+	return switchPending;
+}
+
+uint32_t portTestIrqDisabled(void)
+{
+	return irqDisabled;
+}
+
+void portTestAdvanceCycles(uint32_t delta)
+{
+	cycles += delta;
+}
+
+void portTestSetTickCycles(uint32_t delta)
+{
+	tickCycles = delta;
+}
+
+/*
+ * Con una fuente asignada portGetCycles deja de ser determinista, NULL vuelve al contador
+ * simulado
+ */
+void portTestSetCycleSource(uint32_t (*source)(void))
+{
+	cycleSource = source;
+}
@@ -0,0 +1,86 @@
+/*
+ * JAMMOS_PORT.h
+ *
+ *  Port de prueba de JAMMOS
+ *
+ *  Port determinista para ejecutar el kernel dentro de un harness de pruebas en el host. Las
+ *  tareas nunca se ejecutan: el harness modifica el estado de las tareas y dispara a mano el
+ *  tick (portTestTick), el cambio de contexto (portTestPendSV) y las interrupciones
+ *  (portTestRunIrqs), observando las decisiones del scheduler en la estructura de control
+ *  (osTestGetControl). El contador de ciclos solo avanza con portTestAdvanceCycles, salvo que
+ *  el harness le asigne un reloj del host con portTestSetCycleSource para medir el costo de
+ *  las decisiones del kernel.
+ *
+ *  El kernel se compila con JAMMOS_TEST definido para que scheduler() e initPriority() sean
+ *  visibles. Las APIs que bloquean la tarea actual (osDelay, osTakeSemaphore, osGetQueue,
+ *  etc) esperan un cambio de contexto real y no deben llamarse desde el harness.
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#ifndef PROJECTS_MSE_IOS1_JAMM_PORT_TEST_JAMMOS_PORT_H_
+#define PROJECTS_MSE_IOS1_JAMM_PORT_TEST_JAMMOS_PORT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifndef JAMMOS_TEST
+#error "El port de prueba requiere compilar el kernel con JAMMOS_TEST"
+#endif
+
+#define STACK_SIZE			64		//las tareas no se ejecutan, el stack no se utiliza
+
+#define PORT_TASK_FIELDS
+
+/************************************************************************************
+ * 			Primitivas del port
+ ***********************************************************************************/
+
+typedef uint32_t portIrqState;				//profundidad de deshabilitación guardada
+
+void portDisableIrq(void);
+void portEnableIrq(void);
+portIrqState portSaveAndDisableIrq(void);
+void portRestoreIrq(portIrqState state);
+void portIdleWait(void);
+void portTriggerContextSwitch(void);
+void portInitCycleCounter(void);
+uint32_t portGetCycles(void);
+
+#define portMemoryBarrier()		__atomic_signal_fence(__ATOMIC_SEQ_CST)
+
+#define portCpuFrequency()		(1000000UL)
+#define portCyclesPerTick()		(portCpuFrequency() / OS_TICK_HZ)
+
+uint32_t portGetTickCycles(void);
+
+/************************************************************************************
+ * 			Interrupciones simuladas
+ ***********************************************************************************/
+
+typedef int portIrqType;
+
+#define PORT_IRQ_QUANTITY			32
+
+void portEnableIrqLine(portIrqType irq);
+void portDisableIrqLine(portIrqType irq);
+void portClearIrqLine(portIrqType irq);
+void portRaiseIrq(portIrqType irq);
+
+/************************************************************************************
+ * 			Control del harness
+ ***********************************************************************************/
+
+void portTestTick(void);
+bool portTestPendSV(void);
+void portTestRunIrqs(void);
+bool portTestSwitchPending(void);
+uint32_t portTestIrqDisabled(void);
+void portTestAdvanceCycles(uint32_t cycles);
+void portTestSetTickCycles(uint32_t cycles);
+void portTestSetCycleSource(uint32_t (*source)(void));
+
+#endif /* PROJECTS_MSE_IOS1_JAMM_PORT_TEST_JAMMOS_PORT_H_ */
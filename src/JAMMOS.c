@@ -6,14 +6,38 @@
  */
 
 #include "../inc/JAMMOS.h"
+#include "../inc/JAMMOS_MEM.h"
+#include "../inc/JAMMOS_TRACE.h"
+#include <string.h>
 
 
 /************************************************************************************
  * 			Definición variables Globales
  ***********************************************************************************/
 
-static osCrt crt_OS;
-static task g_idleTask;
+void idleTask(void);
+
+/*
+ * Con JAMMOS_RAMFUNC la estructura de control se ubica, junto con el código de los caminos del
+ * cambio de contexto, el tick y las interrupciones (OS_RAMFUNC), en la SRAM del port
+ */
+OS_INTERNAL osCrt crt_OS OS_RAMBSS;
+
+/*
+ * Si el port define PORT_STACK_STATIC_FRAME el contexto inicial de la tarea idle es un dato
+ * inicializado y initIdleTask no lo arma en el arranque
+ */
+static uint32_t idleStack[STACK_SIZE/4] OS_STACK_SECTION = OS_STACK_FRAME(idleTask);
+OS_INTERNAL task g_idleTask = { .stack_pointer = OS_STACK_POINTER(idleStack), .stack = idleStack };
+
+/*
+ * Pool de bloques fijos del que se obtienen las tareas creadas en tiempo de ejecución. Cada
+ * bloque contiene solo el TCB, el stack de la tarea es el de dynamicStacks con el mismo índice
+ * que el bloque
+ */
+OS_POOL_BUFFER(taskPoolBuffer, sizeof(task), DYNAMIC_TASK_NUMBER);
+static uint32_t dynamicStacks[DYNAMIC_TASK_NUMBER][STACK_SIZE/4] OS_STACK_SECTION;
+static memPool taskPool;
 
 /**********************************************************************************/
 
@@ -21,9 +45,24 @@ static task g_idleTask;
  * 			Definición de funciones estaticas, para no ser vistas y editadas por usuario
  ***********************************************************************************/
 
-static void initIdleTask(void);
-static void initPriority(void);
-static void scheduler(void);
+OS_INTERNAL void initIdleTask(void);
+OS_INTERNAL void initPriority(void);
+OS_INTERNAL void scheduler(void);
+static int8_t allocTaskId(void);
+static void insertSleeping(task *task_sleep, uint32_t wakeTick);
+static void removeSleeping(task *task_sleep);
+static void removeWaiting(task *task_wait);
+#if JAMMOS_SCHED_EDF
+static bool schedulerEdf(void);
+#endif
+#if JAMMOS_SCHED_TT
+static void dispatchFrame(void);
+static bool schedulerTt(void);
+#endif
+#if JAMMOS_BUDGET
+static void chargeBudget(task *task_charge, uint32_t cycles);
+static void replenishBudgets(void);
+#endif
 
 /*==================[definicion de hooks debiles]=================================*/
 
@@ -91,6 +130,59 @@ void __attribute__((weak)) errorHook(void *caller)  {
 	while(1);
 }
 
+/*************************************************************************************************
+	 *  @brief Hook de deadline perdido
+     *
+     *  @details
+     *   Se llama desde osWaitNextPeriod cuando una tarea periódica termina un trabajo luego de
+     *   su deadline absoluto. Se ejecuta en el contexto de la tarea, antes de dormir hasta el
+     *   próximo release.
+     *
+	 *  @param task_miss	Tarea que perdió el deadline.
+	 *
+	 *  @return none.
+***************************************************************************************************/
+void __attribute__((weak)) deadlineMissHook(task *task_miss)  {
+	__asm volatile( "nop" );
+}
+
+/*************************************************************************************************
+	 *  @brief Hook de marco excedido
+     *
+     *  @details
+     *   Se llama desde el handler de SysTick al inicio de cada marco menor si la tarea del marco
+     *   anterior no terminó su trabajo con osWaitNextFrame. La tarea continúa su trabajo en el
+     *   tiempo libre de los marcos siguientes y pierde los marcos propios que transcurran hasta
+     *   que lo termine.
+     *
+	 *  @param task_overrun		Tarea que excedió su marco.
+	 *
+	 *  @return none.
+	 *
+	 *  @warning 	Esta función debe ser corta y no debe utilizar APIs del OS que bloqueen.
+***************************************************************************************************/
+void __attribute__((weak)) frameOverrunHook(task *task_overrun)  {
+	__asm volatile( "nop" );
+}
+
+/*************************************************************************************************
+	 *  @brief Hook de presupuesto agotado
+     *
+     *  @details
+     *   Se llama cuando una tarea agota su presupuesto de ejecución, una única vez por período
+     *   de reposición. La tarea ya fue suspendida hasta la próxima reposición. Se ejecuta dentro
+     *   del handler de SysTick o del cambio de contexto.
+     *
+	 *  @param task_overrun		Tarea que agotó su presupuesto.
+	 *
+	 *  @return none.
+	 *
+	 *  @warning 	Esta función debe ser corta y no debe utilizar APIs del OS que bloqueen.
+***************************************************************************************************/
+void __attribute__((weak)) budgetOverrunHook(task *task_overrun)  {
+	__asm volatile( "nop" );
+}
+
 /*************************************************************************************************
 	 *  @brief Tarea Idle
      *
@@ -104,7 +196,7 @@ void __attribute__((weak)) errorHook(void *caller)  {
 ***************************************************************************************************/
 void __attribute__((weak)) idleTask(void)  {
 	while(1){
-		__WFI();
+		portIdleWait();
 	}
 }
 
@@ -119,8 +211,8 @@ void __attribute__((weak)) idleTask(void)  {
 	 *  @param 		None
 	 *  @return     None
 ***************************************************************************************************/
-inline void osEnterCritical(void)  {
-	__disable_irq();
+OS_RAMFUNC inline void osEnterCritical(void)  {
+	portDisableIrq();
 	crt_OS.countCritical++;
 }
 
@@ -135,10 +227,10 @@ inline void osEnterCritical(void)  {
 	 *  @param 		None
 	 *  @return     None
 ***************************************************************************************************/
-inline void osExitCritical(void)  {
+OS_RAMFUNC inline void osExitCritical(void)  {
 	if (--crt_OS.countCritical <= 0)  {
 		crt_OS.countCritical = 0;
-		__enable_irq();
+		portEnableIrq();
 	}
 }
 
@@ -148,7 +240,7 @@ inline void osExitCritical(void)  {
 	 *  @param 		None
 	 *  @return     bool Estado de la del control del OS.
 ***************************************************************************************************/
-osState osGetSytemState(void)
+OS_RAMFUNC osState osGetSytemState(void)
 {
 	return crt_OS.state;
 }
@@ -159,7 +251,7 @@ osState osGetSytemState(void)
 	 *  @param 		state parametro con el estado que se desea configurar el control del OS
 	 *  @return     none
 ***************************************************************************************************/
-void osSetSytemState(osState state)
+OS_RAMFUNC void osSetSytemState(osState state)
 {
 	crt_OS.state = state;
 }
@@ -171,7 +263,7 @@ void osSetSytemState(osState state)
 	 *  @param 		bool value true o false
 	 *  @return     none
 ***************************************************************************************************/
-void osSetScheduleFromISR(bool value)
+OS_RAMFUNC void osSetScheduleFromISR(bool value)
 {
 	crt_OS.schedulingFromIRQ = value;
 }
@@ -183,7 +275,7 @@ void osSetScheduleFromISR(bool value)
 	 *  @param 		none
 	 *  @return     bool true o false
 ***************************************************************************************************/
-bool osGetScheduleFromISR(void)
+OS_RAMFUNC bool osGetScheduleFromISR(void)
 {
 	return crt_OS.schedulingFromIRQ;
 }
@@ -194,7 +286,7 @@ bool osGetScheduleFromISR(void)
      *  @details
      *   Inicializa una tarea para que pueda correr en el OS implementado.
      *   El usuario debe llamar a esta funcion para cada tarea antes que inicie
-     *   el OS.
+     *   el OS. La tarea debe declararse con OS_TASK, que le asigna su stack.
      *
 	 *  @param *entryPoint			Puntero a la función asociada a la tarea que se desea inicializar.
 	 *  @param *task_init			Puntero a la estructura de la tarea que se desea inicializar.
@@ -202,8 +294,15 @@ bool osGetScheduleFromISR(void)
 ***************************************************************************************************/
 void osInitTask(void *entryPoint, task *task_init, uint8_t priority)
 {
-	static uint8_t id = 0;				/*el id es una variable local pero statica que va
-										 *incrementando a medida que se ingresa una nueva tarea*/
+	/*
+	 * El stack de la tarea no forma parte de la estructura, una tarea declarada sin OS_TASK
+	 * no tiene stack
+	 */
+	if(task_init->stack == NULL)  {
+		crt_OS.err = ERR_OS_TASK_STACK;
+		errorHook(osInitTask);
+		return;
+	}
 
 	/*
 	 * Se efectua un chequeo del número de tareas que se encuentran en el OS y se verifica que no es mayor
@@ -214,41 +313,39 @@ void osInitTask(void *entryPoint, task *task_init, uint8_t priority)
 	if(crt_OS.quantity_task < MAX_TASK_NUMBER)  {
 
 		/*
-		 * Se configura el bit thumb en uno para indicar que solo se trabaja con instrucciones thumb
-		 */
-		task_init->stack[STACK_SIZE/4 - XPSR] = INIT_XPSR;
-
-		/* Se inicializa el registro PC del stack de la tarea con la dirección de la función asociada
-		 * a la tarea, asignandole el parámetro (ENTRY_POINT)
-		 */
-		task_init->stack[STACK_SIZE/4 - PC_REG] = (uint32_t)entryPoint;
-
-		/* Se configura el registro Linker return al hook de retorno, En el caso de que alguna tarea
-		 *  retorne, no deberia pasar nunca, si pasa hay un error.
-		 */
-		task_init->stack[STACK_SIZE/4 - LR] = (uint32_t)returnHook;
-
-		/*
-		 * Se guarda en el stack el valor previo del LR ya que se necesita
-		 * porque el valor del LR en la interrupción de PendSV_Handler
-		 * cambia al llamar la función de cambio de contexto getContextoSiguiente
+		 * Se construye el contexto inicial de la tarea, en Cortex-M su stack frame inicial
 		 */
-		task_init->stack[STACK_SIZE/4 - LR_PREV_VALUE] = EXEC_RETURN;
+		portInitTaskContext(task_init, entryPoint);
 
-		task_init->stack_pointer = (uint32_t) (task_init->stack + STACK_SIZE/4 - FULL_REG_STACKING_SIZE);
-
-		task_init->ticksWaiting = 0; /*
-									* Se inicializa la variable dee conteo de la función osDelay a 0
+		task_init->sleeping = false; /*
+									* La tarea inicia fuera de la lista de tareas dormidas de osDelay
 		 	 	 	 	 	 	 	*/
+		task_init->nextSleep = NULL;
+		task_init->waitList = NULL;
+		task_init->nextWait = NULL;
+		task_init->waitTimeout = false;
+		task_init->period = 0;
+		task_init->relDeadline = 0;
+		task_init->deadlineMisses = 0;
+#if JAMMOS_SCHED_TT
+		task_init->ttWaiting = false;
+#endif
+#if JAMMOS_BUDGET
+		task_init->budget = 0;
+		task_init->budgetSuspended = false;
+#endif
+#if JAMMOS_CPU_USAGE
+		task_init->cpuCycles = 0;
+#endif
 
 		/*
 		 * En esta parte se asigna a las variables de la estructura de la tarea inicializada;
 		 * el entryPoint (dirección de la función asociada a la tarea),
-		 * el id que se assigna con la variable estatica que incrementa a cada inicialización de tarea,
+		 * el id que se toma del primer id libre del mapa de id en uso,
 		 * y el estado de la tarea que se inicializa con READY, todas se inicializan con ese estado.
 		 */
 		task_init->entry_point = entryPoint;
-		task_init->id = id;
+		task_init->id = allocTaskId();
 		task_init->state = READY;
 
 		/*
@@ -263,16 +360,15 @@ void osInitTask(void *entryPoint, task *task_init, uint8_t priority)
 		else{
 			task_init->priority = PRIORITY_MIN;
 		}
+		task_init->threshold = task_init->priority;
 
 		/*
 		 * Se guarda en el vector de tareas de la estructura de control del sistema operativo la tarea
-		 * inicializada en la posición id que es correlativa al ingreso de tareas y se incrementa
+		 * inicializada a continuación de la última tarea y se incrementa
 		 * la variable que contiene la información de la cantidad de tareas del Sistema Operativo
 		 */
-		crt_OS.taskList[id] = task_init;
+		crt_OS.taskList[crt_OS.quantity_task] = task_init;
 		crt_OS.quantity_task++;
-
-		id++;
 	}
 
 	else {
@@ -290,39 +386,240 @@ void osInitTask(void *entryPoint, task *task_init, uint8_t priority)
 }
 
 /*************************************************************************************************
-	 *  @brief Inicializa la tarea idle del OS
+	 *  @brief Registra una tabla de tareas declarada con OS_TASK_TABLE
      *
      *  @details
-     *   Inicializa una tarea estatica idle que se debe llamar en el sistema y no debe ser vista ni
-     *   editada por el usuario
+     *   Las tareas de la tabla ya tienen sus campos y su contexto inicial como datos
+     *   inicializados, solo se agregan al vector de tareas del OS. Los id de las tareas son su
+     *   índice en la tabla, por lo que la tabla debe registrarse antes que cualquier otra tarea
+     *   (osInitTask) y antes de osInit, que arma la matriz de prioridades. Si el port no define
+     *   PORT_STACK_STATIC_FRAME aquí se arma el contexto inicial de cada tarea.
      *
-	 *  @return     None.
-	 *  @return     None.
+	 *  @param table	Tabla de tareas definida con OS_TASK_TABLE.
+	 *  @return none.
 ***************************************************************************************************/
-static void initIdleTask(void)
+void osInitTaskTable(const taskTable *table)
 {
-	/* Se configura el bit thumb en uno para indicar que solo se trabaja con instrucciones thumb
-	 */
-	g_idleTask.stack[STACK_SIZE/4 - XPSR] = INIT_XPSR;
+	task *task_table;
+	uint8_t i;
+
+	if(crt_OS.quantity_task != 0)  {
+		crt_OS.err = ERR_OS_TASK_TABLE;
+		errorHook(osInitTaskTable);
+		return;
+	}
+
+	for(i = 0; i < table->quantity_task; i++)  {
+		task_table = table->tasks[i];
 
-	/* Se inicializa el registro PC del stack de la tarea con la dirección de la función
-	 * asociada a la tarea, asignandole el parámetro (ENTRY_POINT)
+		if(task_table->stack_pointer == 0)
+			portInitTaskContext(task_table, task_table->entry_point);
+
+		crt_OS.taskList[i] = task_table;
+		crt_OS.usedIds |= 1UL << task_table->id;
+	}
+
+	crt_OS.quantity_task = table->quantity_task;
+}
+
+/*************************************************************************************************
+	 *  @brief Obtiene un id de tarea libre
+     *
+     *  @details
+     *   Busca el primer bit en cero del mapa de id en uso, lo marca y lo devuelve. De esta forma
+     *   los id de las tareas eliminadas se reutilizan.
+     *
+	 *  @param 		None.
+	 *  @return     id libre o -1 si no hay id disponibles.
+***************************************************************************************************/
+static int8_t allocTaskId(void)
+{
+	int8_t id;
+
+	for(id = 0; id < MAX_TASK_NUMBER; id++)  {
+		if((crt_OS.usedIds & (1UL << id)) == 0)  {
+			crt_OS.usedIds |= (1UL << id);
+			return id;
+		}
+	}
+	return -1;
+}
+
+/*************************************************************************************************
+	 *  @brief Crea una tarea en tiempo de ejecución
+     *
+     *  @details
+     *   Obtiene la estructura de la tarea (TCB y stack) del pool de tareas en tiempo constante,
+     *   construye su stack frame inicial y la agrega al vector de tareas y a la matriz de
+     *   prioridades dentro de una sección crítica. La tarea queda en estado READY y se ejecuta
+     *   en el próximo scheduling. Solo puede llamarse desde tareas luego de osInit.
+     *
+	 *  @param *entryPoint			Puntero a la función asociada a la tarea.
+	 *  @param priority				Prioridad de la tarea.
+	 *  @return     Puntero a la tarea creada o NULL si no hay lugar en el OS o en el pool.
+***************************************************************************************************/
+task* osCreateTask(void *entryPoint, uint8_t priority)
+{
+	task *task_new;
+
+	if(crt_OS.quantity_task >= MAX_TASK_NUMBER)
+		return NULL;
+
+	task_new = osPoolAlloc(&taskPool);
+	if(task_new == NULL)
+		return NULL;
+
+	task_new->stack = dynamicStacks[((uint8_t*)task_new - (uint8_t*)taskPoolBuffer) / POOL_BLOCK_SIZE(sizeof(task))];
+	portInitTaskContext(task_new, entryPoint);
+	task_new->sleeping = false;
+	task_new->nextSleep = NULL;
+	task_new->waitList = NULL;
+	task_new->nextWait = NULL;
+	task_new->waitTimeout = false;
+	task_new->period = 0;
+	task_new->relDeadline = 0;
+	task_new->deadlineMisses = 0;
+#if JAMMOS_SCHED_TT
+	task_new->ttWaiting = false;
+#endif
+#if JAMMOS_BUDGET
+	task_new->budget = 0;
+	task_new->budgetSuspended = false;
+#endif
+#if JAMMOS_CPU_USAGE
+	task_new->cpuCycles = 0;
+#endif
+	task_new->entry_point = entryPoint;
+	task_new->priority = (priority <= PRIORITY_MIN) ? priority : PRIORITY_MIN;
+	task_new->threshold = task_new->priority;
+
+	osEnterCritical();
+	/*
+	 * Se vuelve a verificar la cantidad de tareas dentro de la sección crítica, otra tarea
+	 * pudo haber creado una tarea entre la primera verificación y este punto
 	 */
-	g_idleTask.stack[STACK_SIZE/4 - PC_REG] = (uint32_t)idleTask;
+	if(crt_OS.quantity_task >= MAX_TASK_NUMBER)  {
+		osExitCritical();
+		osPoolFree(&taskPool, task_new);
+		return NULL;
+	}
+	task_new->id = allocTaskId();
+	task_new->state = READY;
+	crt_OS.taskList[crt_OS.quantity_task] = task_new;
+	crt_OS.quantity_task++;
+	crt_OS.taskPriority[task_new->priority][crt_OS.countPriority[task_new->priority]] = task_new;
+	crt_OS.countPriority[task_new->priority]++;
+	osExitCritical();
+
+	OS_TRACE(TRACE_TASK_CREATE, task_new->id);
+
+	return task_new;
+}
+
+/*************************************************************************************************
+	 *  @brief Elimina una tarea en tiempo de ejecución
+     *
+     *  @details
+     *   Quita la tarea del vector de tareas y de la matriz de prioridades, conservando el orden
+     *   de las demás tareas para no alterar el round robin, y libera su id. Si la tarea fue
+     *   creada con osCreateTask su bloque se devuelve al pool; cuando la tarea se elimina a si
+     *   misma el bloque se libera en getNextContext, luego de dejar de usar su stack.
+     *
+	 *  @param *task_delete		Tarea a eliminar, NULL para eliminar la tarea actual.
+	 *  @return     bool true si la tarea se eliminó.
+***************************************************************************************************/
+bool osDeleteTask(task *task_delete)
+{
+	uint8_t i, j;
+	uint8_t priority;
+	bool found = false;
+	bool deleteCurrent;
+
+	osEnterCritical();
+
+	if(task_delete == NULL)
+		task_delete = crt_OS.current_task;
+
+	for(i = 0; i < crt_OS.quantity_task; i++)  {
+		if(crt_OS.taskList[i] == task_delete)
+			found = true;
+		if(found && i + 1 < crt_OS.quantity_task)
+			crt_OS.taskList[i] = crt_OS.taskList[i + 1];
+	}
+
+	if(!found)  {
+		osExitCritical();
+		return false;
+	}
+
+	crt_OS.quantity_task--;
+	crt_OS.taskList[crt_OS.quantity_task] = NULL;
+
+	priority = task_delete->priority;
+	for(j = 0, i = 0; i < crt_OS.countPriority[priority]; i++)  {
+		if(crt_OS.taskPriority[priority][i] != task_delete)
+			crt_OS.taskPriority[priority][j++] = crt_OS.taskPriority[priority][i];
+	}
+	crt_OS.countPriority[priority] = j;
 
-	/* Se configura el registro Linker return al hook de retorno. En el caso de que alguna tarea
-	 * retorne, no deberia pasar nunca, si pasa hay un error.
+	crt_OS.usedIds &= ~(1UL << task_delete->id);
+	OS_TRACE(TRACE_TASK_DELETE, task_delete->id);
+
+	/*
+	 * Si la tarea estaba dormida o esperando en una cola o semáforo se quita de las listas
 	 */
+	if(task_delete->sleeping)
+		removeSleeping(task_delete);
+	if(task_delete->waitList != NULL)
+		removeWaiting(task_delete);
+#if JAMMOS_BUDGET
+	if(task_delete->budget != 0)
+		crt_OS.budgetTasks--;
+#endif
+#if JAMMOS_SCHED_TT
+	if(crt_OS.ttTask == task_delete)
+		crt_OS.ttTask = NULL;
+#endif
 
-	g_idleTask.stack[STACK_SIZE/4 - LR] = (uint32_t)returnHook;
 	/*
-	 * Se guarda en el stack el valor previo del LR ya que se necesita
-	 * porque el valor del LR en la interrupción de PendSV_Handler
-	 * cambia al llamar la funcion de cambio de contexto getContextoSiguiente
+	 * La tarea queda bloqueada para que getNextContext no la vuelva a pasar a READY
 	 */
-	g_idleTask.stack[STACK_SIZE/4 - LR_PREV_VALUE] = EXEC_RETURN;
+	task_delete->state = BLOCKED;
+	deleteCurrent = (task_delete == crt_OS.current_task);
+
+	if(deleteCurrent)
+		crt_OS.deletedTask = task_delete;
+	else if(osPoolContains(&taskPool, task_delete))
+		osPoolFree(&taskPool, task_delete);
+
+	osExitCritical();
 
-	g_idleTask.stack_pointer = (uint32_t) (g_idleTask.stack + STACK_SIZE/4 - FULL_REG_STACKING_SIZE);
+	if(deleteCurrent)  {
+		osForceSchCC();
+		while(1);
+	}
+
+	return true;
+}
+
+/*************************************************************************************************
+	 *  @brief Inicializa la tarea idle del OS
+     *
+     *  @details
+     *   Inicializa una tarea estatica idle que se debe llamar en el sistema y no debe ser vista ni
+     *   editada por el usuario
+     *
+	 *  @return     None.
+	 *  @return     None.
+***************************************************************************************************/
+OS_INTERNAL void initIdleTask(void)
+{
+	/*
+	 * Se construye el contexto inicial de la tarea idle si no es un dato inicializado
+	 */
+	g_idleTask.stack = idleStack;
+	if(g_idleTask.stack_pointer == 0)
+		portInitTaskContext(&g_idleTask, idleTask);
 
 	/*
 	 * En esta parte se asigna a las variables de la estructura de la tarea inicializada;
@@ -347,13 +644,6 @@ static void initIdleTask(void)
 	 *  @return     None.
 ***************************************************************************************************/
 void osInit(void) {
-	/*
-	 * Todas las interrupciones tienen prioridad 0 (la maxima) al iniciar la ejecucion. Para que
-	 * no se de la condicion de fault mencionada en la teoria, debemos bajar su prioridad en el
-	 * NVIC. La cuenta matematica que se observa da la probabilidad mas baja posible.
-	 */
-	NVIC_SetPriority(PendSV_IRQn, (1 << __NVIC_PRIO_BITS)-1); // @suppress("Symbol is not resolved")
-
 	/*
 	 * Al iniciar el OS se especifica que se encuentra en la primer ejecucion desde un reset.
 	 * Este estado es util para cuando se debe ejecutar el primer cambio de contexto. Los
@@ -363,6 +653,9 @@ void osInit(void) {
 	crt_OS.current_task = NULL;
 	crt_OS.countCritical = 0;
 	crt_OS.next_task = NULL;
+	crt_OS.tickCount = 0;
+	crt_OS.contextSwitches = 0;
+	crt_OS.sleepList = NULL;
 
 	/*
 	 * Función que realiza la inicialización de la tarea Idle, esta tarea es de naturaleza estática
@@ -376,6 +669,32 @@ void osInit(void) {
 	 */
 	initPriority();
 
+	/*
+	 * Se inicializa el pool del que se obtienen las tareas creadas con osCreateTask
+	 */
+	osInitPool(&taskPool, taskPoolBuffer, sizeof(task), DYNAMIC_TASK_NUMBER);
+
+	/*
+	 * Se inicializan los pools de las clases de tamaño del asignador osMemAlloc
+	 */
+	osInitMem();
+
+#if JAMMOS_CPU_USAGE || JAMMOS_TRACE || JAMMOS_IRQ_STATS || JAMMOS_BUDGET
+	/*
+	 * Se habilita el contador de ciclos del port (DWT CYCCNT en Cortex-M) que se utiliza para
+	 * medir el tiempo de CPU de cada tarea, la duración de las interrupciones, descontar los
+	 * presupuestos de ejecución y como marca de tiempo del trace
+	 */
+	portInitCycleCounter();
+#endif
+#if JAMMOS_CPU_USAGE
+	crt_OS.lastSwitchCycles = 0;
+	crt_OS.windowStartCycles = 0;
+#endif
+#if JAMMOS_BUDGET
+	crt_OS.lastChargeCycles = 0;
+#endif
+
 	/*
 	 * El vector de tareas termina de inicializarse asignando NULL a las posiciones que estan
 	 * luego de la ultima tarea. Esta situacion se da cuando se definen menos de 8 tareas.
@@ -385,6 +704,12 @@ void osInit(void) {
 		if(i>=crt_OS.quantity_task)
 			crt_OS.taskList[i] = NULL;
 	}
+
+	/*
+	 * Por último se inicializa el port: en Cortex-M se baja la prioridad de PendSV al mínimo,
+	 * en el port POSIX además se arranca el timer que simula el SysTick
+	 */
+	portInit();
 }
 
 /*************************************************************************************************
@@ -398,7 +723,7 @@ void osInit(void) {
 	 *  @param 		None.
 	 *  @return     None.
 ***************************************************************************************************/
-static void initPriority(void)
+OS_INTERNAL void initPriority(void)
 {
 	uint8_t ind = 0;
 	uint8_t priority = 0;
@@ -455,121 +780,609 @@ int32_t os_getError(void)  {
 }
 
 /*************************************************************************************************
-	 *  @brief Función que getCurrentTaskOS
+	 *  @brief Asigna el umbral de desalojo de una tarea
      *
      *  @details
-	 *  Función que devuelve como parametro la tarea actual del sistema
+     *   Mientras la tarea está en ejecución solo puede ser desalojada por tareas de prioridad
+     *   mayor que el umbral; al bloquearse el CPU se asigna normalmente por prioridad. Un umbral
+     *   igual a la prioridad de la tarea es el comportamiento habitual (incluido el round robin
+     *   entre tareas de igual prioridad). Las tareas que se comunican entre sí pueden formar un
+     *   grupo no desalojable asignando a todas como umbral la mayor prioridad del grupo, así
+     *   se reducen los cambios de contexto entre ellas. Con JAMMOS_SCHED_EDF el umbral solo
+     *   se aplica a las tareas no periódicas.
+     *
+	 *  @param task_threshold	Tarea a configurar.
+	 *  @param threshold		Umbral, entre PRIORITY_MAX y la prioridad de la tarea.
+	 *  @return true si el umbral es válido y se asignó.
+***************************************************************************************************/
+bool osSetTaskThreshold(task *task_threshold, uint8_t threshold)
+{
+	if(threshold > task_threshold->priority)
+		return false;
+
+	osEnterCritical();
+	task_threshold->threshold = threshold;
+	osExitCritical();
+
+	return true;
+}
+
+/*************************************************************************************************
+	 *  @brief Devuelve la cantidad de cambios de contexto desde osInit
+     *
+     *  @details
+     *   Se incrementa en cada cambio de contexto realizado en getNextContext. La diferencia
+     *   entre dos lecturas, con la resta sin signo, es válida aunque el contador desborde.
      *
 	 *  @param none
-	 *  @return task Tarea actual en el sistema de control del OS
+	 *  @return Cambios de contexto desde osInit.
 ***************************************************************************************************/
-task* getCurrentTask(void)
+uint32_t osGetContextSwitches(void)
 {
-	return crt_OS.current_task;
+	return crt_OS.contextSwitches;
 }
 
 /*************************************************************************************************
-	 *  @brief Forzado de Scheduling (Llama al scheduler y a cambio de contexto si es necesario)
+	 *  @brief Devuelve el contador de ticks del OS
      *
      *  @details
-     *  Función que llama al scheuler y al cambio de contexto si es necesario
-     *  llama a la funcion scheuler y reviza la bandera de cambio de contexto y llama a la
-     *  interupcion PENDSVSET para realizar cambio de contexto si es necesario.
+     *   32 bits bajos de la cantidad de ticks de sistema desde osInit. El valor desborda cada
+     *   2^32 ticks, las comparaciones entre ticks deben hacerse con la diferencia con signo.
+     *   Es la base de tiempo de osDelayUntil y osSleepUntil.
      *
-	 *  @param 		None
-	 *  @return     None.
+	 *  @param none
+	 *  @return Ticks desde osInit (módulo 2^32).
 ***************************************************************************************************/
-void osForceSchCC(void){
-	scheduler();
-	if(crt_OS.contexSwitch)
-	{
-		/**
-		 * Se setea el bit correspondiente a la excepcion PendSV
-		 */
-		SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+uint32_t osGetTickCount(void)
+{
+	return (uint32_t)crt_OS.tickCount;
+}
 
-		/**
-		 * Instruction Synchronization Barrier; flushes the pipeline and ensures that
-		 * all previous instructions are completed before executing new instructions
-		 */
-		__ISB();
+/*************************************************************************************************
+	 *  @brief Devuelve el contador de ticks del OS de 64 bits
+     *
+     *  @details
+     *   El contador de 64 bits no desborda en la vida útil del sistema. En Cortex-M su lectura
+     *   no es atómica, por lo que se lee con las interrupciones enmascaradas. Puede llamarse
+     *   desde tareas e interrupciones.
+     *
+	 *  @param none
+	 *  @return Ticks desde osInit.
+***************************************************************************************************/
+uint64_t osGetTickCount64(void)
+{
+	portIrqState irqState;
+	uint64_t ticks;
 
-		/**
-		 * Data Synchronization Barrier; ensures that all memory accesses are
-		 * completed before next instruction is executed
-		 */
-		__DSB();
-	}
+	irqState = portSaveAndDisableIrq();
+	ticks = crt_OS.tickCount;
+	portRestoreIrq(irqState);
+
+	return ticks;
 }
 
 /*************************************************************************************************
-	 *  @brief Funcion que efectua las decisiones de scheduling.
+	 *  @brief Devuelve el tiempo desde osInit en ciclos
      *
      *  @details
+     *   Combina el contador de ticks con los ciclos transcurridos dentro del tick actual, que
+     *   el port obtiene de la cuenta del SysTick (o del reloj del host en el port POSIX). Si el
+     *   SysTick desbordó y su interrupción todavía no se atendió el port suma el tick
+     *   pendiente, de forma que el tiempo es monótono también dentro de secciones críticas e
+     *   interrupciones.
      *
-     *   La función contiene el scheduler que determinar la siguiente tarea que se va a ejecutar
-     *   verificando el estado del OS.
-     *
-	 *  @param 		None.
-	 *  @return     None.
+	 *  @param none
+	 *  @return Ciclos desde osInit.
 ***************************************************************************************************/
-static void scheduler(void) {
+uint64_t osGetTimeCycles(void)
+{
+	portIrqState irqState;
+	uint64_t ticks;
+	uint32_t cycles;
 
-	static uint8_t priorityIndex[PRIORITY_SIZE];
-	uint8_t blockedTasks[PRIORITY_SIZE];
+	irqState = portSaveAndDisableIrq();
+	ticks = crt_OS.tickCount;
+	cycles = portGetTickCycles();
+	portRestoreIrq(irqState);
 
-	uint8_t i = 0;
-	uint8_t priority = PRIORITY_MAX;
-	uint8_t priorityAux = PRIORITY_MAX;
+	return ticks * portCyclesPerTick() + cycles;
+}
 
-	uint8_t indexTask = 0;
+/*************************************************************************************************
+	 *  @brief Devuelve el tiempo desde osInit en nanosegundos
+     *
+     *  @details
+     *   Igual que osGetTimeCycles, la resolución es la del reloj del SysTick. La parte de ticks
+     *   se convierte sin división y solo los ciclos dentro del tick se escalan con la
+     *   frecuencia del CPU, para que la conversión no desborde.
+     *
+	 *  @param none
+	 *  @return Nanosegundos desde osInit.
+***************************************************************************************************/
+uint64_t osGetTimeNs(void)
+{
+	portIrqState irqState;
+	uint64_t ticks;
+	uint32_t cycles;
 
-	bool flag = true;
+	irqState = portSaveAndDisableIrq();
+	ticks = crt_OS.tickCount;
+	cycles = portGetTickCycles();
+	portRestoreIrq(irqState);
 
-	bool priorityChange = false;
+	return ticks * (1000000000ULL / OS_TICK_HZ) + ((uint64_t)cycles * 1000000000ULL) / portCpuFrequency();
+}
 
-	/*
-	 * Se cuenta con un vector (priorityIndex) que contiene los indices para recorrer cada uno de los
-	 * vectores de las prioridades alojados en el vector bidimencional (taskPriority)
-	 *
-	 * Se cuenta también con un vector (blockedTasks) se clarea cada vez que entra al scheduler
-	 * y que contiene el número de tareas bloqueadas en cada uno de los vectores de prioridad.
-	 *
-	 * Se tiene una variable priority que sirve para recorrer el primer campo (campo de prioridades) del vector
-	 * bidimencional (taskPriority), este incrementa cada vez que el algoritmo verifica que todas las tareas
-	 * de una prioridad mayor estan bloqueadas
-	 *
-	 * La variable indexTask se utiliza como índice temporal para recorrer las tareas en los
-	 * vectores de las prioridades
-	 *
-	 * La bandera (flag) sirve para verificar si se debe salir o no del blucle de verificación de prioridades.
-	 *
-	 * La bandera (priorityChange) sirve para verificar si hubo un cambio de prioridad realizar las comparaciones
-	 * con la prioridad anterior
-	 *
-	 * Primero se verifica si el estado del Sistema Operativo es después de un Reset, si viene de un reset
-	 * la tarea actual se carga con la tarea Idle del OS.
-	 *
-	 * Se clarea el tambien el vector (priorityIndex).
-	 *
-	 */
+/*************************************************************************************************
+	 *  @brief Duerme la tarea actual hasta un tick absoluto
+     *
+     *  @details
+     *   Inserta la tarea actual en la lista de tareas dormidas, ordenada por tick de despertar,
+     *   la bloquea y fuerza un scheduling. El SysTick la pasa a READY una única vez al alcanzar
+     *   wakeTick, de forma que la tarea no vuelve a entrar al scheduler mientras duerme. Si
+     *   wakeTick ya pasó la función retorna sin bloquear.
+     *
+	 *  @param wakeTick		Tick absoluto de despertar (ver osGetTickCount).
+	 *  @return none.
+***************************************************************************************************/
+void osSleepUntil(uint32_t wakeTick)
+{
+	task *currentTask;
 
-	if(crt_OS.state == FROM_RESET){
-		crt_OS.current_task = &g_idleTask;
-		crt_OS.contexSwitch = true;
+	osEnterCritical();
 
-		for(i=0; i < PRIORITY_SIZE; i++)
-			priorityIndex[i] = 0;
+	if((int32_t)(wakeTick - (uint32_t)crt_OS.tickCount) <= 0)  {
+		osExitCritical();
+		return;
 	}
-	else {
 
-		/**
-		 * Se verifica el estado del control del OS, si se encuentra en estado SCHEDULING no se
-		 * ejecuta el algoritmo y la función retorna.
-		 * Se realiza en este parte de la función porque siempre entra a este apartado
-		 * deferente de cuando viene de RESET.
-		 */
-		if(crt_OS.state == SCHEDULING)
+	currentTask = crt_OS.current_task;
+	insertSleeping(currentTask, wakeTick);
+	currentTask->state = BLOCKED;
+
+	osExitCritical();
+
+	osForceSchCC();
+}
+
+/*************************************************************************************************
+	 *  @brief Configura una tarea como periódica
+     *
+     *  @details
+     *   El primer trabajo se libera en el tick actual (en el tick 0 si se llama antes de osInit)
+     *   y cada trabajo tiene como deadline absoluto su release más relDeadline. La tarea indica
+     *   el fin de cada trabajo con osWaitNextPeriod. Con JAMMOS_SCHED_EDF el scheduler elige
+     *   entre las tareas periódicas listas la de deadline más próximo, con la política de
+     *   prioridades el período y el deadline solo se usan para contar los deadlines perdidos.
+     *
+	 *  @param task_periodic	Tarea a configurar.
+	 *  @param period			Período en ticks, 0 para que la tarea deje de ser periódica.
+	 *  @param relDeadline		Deadline relativo en ticks, 0 para usar el período.
+	 *  @return none.
+***************************************************************************************************/
+void osSetTaskPeriod(task *task_periodic, uint32_t period, uint32_t relDeadline)
+{
+	osEnterCritical();
+	task_periodic->period = period;
+	task_periodic->relDeadline = (period != 0 && relDeadline == 0) ? period : relDeadline;
+	task_periodic->releaseTick = (uint32_t)crt_OS.tickCount;
+	task_periodic->deadline = task_periodic->releaseTick + task_periodic->relDeadline;
+	task_periodic->deadlineMisses = 0;
+	osExitCritical();
+}
+
+/*************************************************************************************************
+	 *  @brief Fin del trabajo actual de una tarea periódica
+     *
+     *  @details
+     *   Verifica si el trabajo terminó dentro de su deadline, si no lo hizo incrementa el
+     *   contador de deadlines perdidos y llama a deadlineMissHook. Luego duerme la tarea hasta
+     *   el release del próximo trabajo, que se calcula desde el release anterior como en
+     *   osDelayUntil. Si el próximo release ya pasó la tarea continúa sin dormir.
+     *
+	 *  @param none
+	 *  @return true si el trabajo terminó dentro de su deadline.
+***************************************************************************************************/
+bool osWaitNextPeriod(void)
+{
+	task *currentTask = crt_OS.current_task;
+	uint32_t releaseTick;
+	bool deadlineMet;
+
+	osEnterCritical();
+	deadlineMet = (int32_t)((uint32_t)crt_OS.tickCount - currentTask->deadline) <= 0;
+	if(!deadlineMet)
+		currentTask->deadlineMisses++;
+
+	currentTask->releaseTick += currentTask->period;
+	currentTask->deadline = currentTask->releaseTick + currentTask->relDeadline;
+	releaseTick = currentTask->releaseTick;
+	osExitCritical();
+
+	if(!deadlineMet)
+		deadlineMissHook(currentTask);
+
+	osSleepUntil(releaseTick);
+
+	return deadlineMet;
+}
+
+#if JAMMOS_SCHED_TT
+/*************************************************************************************************
+	 *  @brief Instala la tabla del ejecutivo cíclico
+     *
+     *  @details
+     *   Las tareas de la tabla quedan esperando su marco y el primer marco menor comienza en el
+     *   próximo tick. Con NULL se desinstala la tabla, las tareas que esperaban su marco pasan
+     *   a READY y el scheduling vuelve a la política por prioridades (o EDF). Debe llamarse
+     *   antes de osInit o desde una tarea que no está en la tabla, y las tareas de la tabla no
+     *   deben eliminarse mientras esté instalada.
+     *
+	 *  @param table		Tabla a instalar, normalmente definida con OS_TT_SCHEDULE.
+	 *  @return none.
+***************************************************************************************************/
+void osSetScheduleTable(const ttSchedule *table)
+{
+	const ttSchedule *oldTable;
+	uint8_t i;
+
+	if(table != NULL && (table->minorTicks == 0 || table->minorFrames == 0 || table->slots == NULL))  {
+		crt_OS.err = ERR_OS_TT_TABLE;
+		errorHook(osSetScheduleTable);
+		return;
+	}
+
+	osEnterCritical();
+	oldTable = crt_OS.ttTable;
+	if(oldTable != NULL)  {
+		for(i = 0; i < oldTable->minorFrames; i++)  {
+			if(oldTable->slots[i] != NULL && oldTable->slots[i]->ttWaiting)  {
+				oldTable->slots[i]->ttWaiting = false;
+				oldTable->slots[i]->state = READY;
+			}
+		}
+	}
+
+	if(table != NULL)  {
+		for(i = 0; i < table->minorFrames; i++)  {
+			if(table->slots[i] != NULL)  {
+				table->slots[i]->ttWaiting = true;
+				table->slots[i]->state = BLOCKED;
+			}
+		}
+	}
+
+	crt_OS.ttTable = table;
+	crt_OS.ttFrame = 0;
+	crt_OS.ttTicksLeft = 1;
+	crt_OS.ttTask = NULL;
+	crt_OS.ttOverruns = 0;
+	osExitCritical();
+}
+
+/*************************************************************************************************
+	 *  @brief Fin del trabajo del marco actual
+     *
+     *  @details
+     *   La tarea de la tabla indica que terminó el trabajo de su marco menor y espera hasta el
+     *   inicio del próximo marco que tiene asignado. El tiempo restante del marco queda libre
+     *   para las tareas que no están en la tabla.
+     *
+	 *  @param none
+	 *  @return true si el trabajo terminó dentro de su marco.
+***************************************************************************************************/
+bool osWaitNextFrame(void)
+{
+	task *currentTask = crt_OS.current_task;
+	bool inFrame;
+
+	osEnterCritical();
+	inFrame = (crt_OS.ttTask == currentTask);
+	currentTask->ttWaiting = true;
+	currentTask->state = BLOCKED;
+	osExitCritical();
+
+	osForceSchCC();
+
+	return inFrame;
+}
+
+/*************************************************************************************************
+	 *  @brief Cantidad de marcos excedidos
+     *
+	 *  @param none
+	 *  @return Marcos menores cuya tarea no terminó su trabajo antes del fin del marco, desde
+	 *  		que se instaló la tabla.
+***************************************************************************************************/
+uint32_t osGetFrameOverruns(void)
+{
+	return crt_OS.ttOverruns;
+}
+#endif
+
+/*************************************************************************************************
+	 *  @brief Bloquea la tarea actual en una lista de espera
+     *
+     *  @details
+     *   Primitiva de las APIs bloqueantes (semáforos y colas). Inserta la tarea actual en la
+     *   lista de espera, ordenada por prioridad, y si el timeout no es OS_WAIT_FOREVER también
+     *   en la lista de tareas dormidas, de forma que el timeout no tiene costo hasta que vence.
+     *   La tarea despierta por osSignalEvent o por el SysTick al vencer el timeout, y en ambos
+     *   casos sale de las dos listas.
+     *
+     *   Debe llamarse dentro de una sección crítica de un solo nivel, que se libera mientras la
+     *   tarea está bloqueada y se vuelve a tomar antes de retornar. Así la condición que espera
+     *   la tarea se verifica sin que un evento se pierda entre la verificación y el bloqueo. Con
+     *   timeout OS_NO_WAIT o desde una interrupción retorna false sin bloquear.
+     *
+	 *  @param waitList		Lista de espera del objeto.
+	 *  @param timeout		Ticks de espera máxima, OS_WAIT_FOREVER u OS_NO_WAIT.
+	 *  @return true si la tarea despertó por el evento, false por timeout.
+***************************************************************************************************/
+bool osWaitEvent(task **waitList, uint32_t timeout)
+{
+	task *currentTask = crt_OS.current_task;
+	task **link;
+
+	if(timeout == OS_NO_WAIT || crt_OS.state == RUN_IRQ)
+		return false;
+
+	/*
+	 * Las tareas de igual prioridad quedan en orden de llegada
+	 */
+	link = waitList;
+	while(*link != NULL && (*link)->priority <= currentTask->priority)
+		link = &(*link)->nextWait;
+
+	currentTask->nextWait = *link;
+	*link = currentTask;
+	currentTask->waitList = waitList;
+	currentTask->waitTimeout = false;
+
+	if(timeout != OS_WAIT_FOREVER)
+		insertSleeping(currentTask, (uint32_t)crt_OS.tickCount + timeout);
+
+	currentTask->state = BLOCKED;
+
+	osExitCritical();
+	osForceSchCC();
+	osEnterCritical();
+
+	return !currentTask->waitTimeout;
+}
+
+/*************************************************************************************************
+	 *  @brief Despierta la primera tarea de una lista de espera
+     *
+     *  @details
+     *   Pasa a READY la tarea de mayor prioridad de la lista de espera y la quita de la lista
+     *   de tareas dormidas si esperaba con timeout. No fuerza el scheduling. Debe llamarse
+     *   dentro de una sección crítica, puede llamarse desde una interrupción.
+     *
+	 *  @param waitList		Lista de espera del objeto.
+	 *  @return true si había una tarea esperando.
+***************************************************************************************************/
+bool osSignalEvent(task **waitList)
+{
+	task *waitTask = *waitList;
+
+	if(waitTask == NULL)
+		return false;
+
+	*waitList = waitTask->nextWait;
+	waitTask->nextWait = NULL;
+	waitTask->waitList = NULL;
+
+	if(waitTask->sleeping)
+		removeSleeping(waitTask);
+
+	waitTask->state = READY;
+
+	return true;
+}
+
+/*************************************************************************************************
+	 *  @brief Despierta todas las tareas de una lista de espera
+     *
+     *  @details
+     *   Pasa a READY todas las tareas de la lista de espera, de modo que un único scheduling
+     *   posterior elige entre todas ellas. No fuerza el scheduling. Debe llamarse dentro de una
+     *   sección crítica, puede llamarse desde una interrupción.
+     *
+	 *  @param waitList		Lista de espera del objeto.
+	 *  @return cantidad de tareas despertadas.
+***************************************************************************************************/
+uint8_t osBroadcastEvent(task **waitList)
+{
+	uint8_t woken = 0;
+
+	while(osSignalEvent(waitList))
+		woken++;
+
+	return woken;
+}
+
+/*************************************************************************************************
+	 *  @brief Inserta una tarea en la lista de tareas dormidas
+     *
+     *  @details
+     *   La lista está ordenada por tick de despertar, las tareas con el mismo tick quedan en
+     *   orden de llegada. Debe llamarse dentro de una sección crítica.
+     *
+	 *  @param task_sleep	Tarea a insertar.
+	 *  @param wakeTick		Tick absoluto de despertar.
+	 *  @return none.
+***************************************************************************************************/
+static void insertSleeping(task *task_sleep, uint32_t wakeTick)
+{
+	task **link = &crt_OS.sleepList;
+
+	while(*link != NULL && (int32_t)((*link)->wakeTick - wakeTick) <= 0)
+		link = &(*link)->nextSleep;
+
+	task_sleep->wakeTick = wakeTick;
+	task_sleep->nextSleep = *link;
+	*link = task_sleep;
+	task_sleep->sleeping = true;
+}
+
+/*************************************************************************************************
+	 *  @brief Quita una tarea de la lista de tareas dormidas
+     *
+     *  @details
+     *   Debe llamarse dentro de una sección crítica.
+     *
+	 *  @param task_sleep	Tarea a quitar.
+	 *  @return none.
+***************************************************************************************************/
+static void removeSleeping(task *task_sleep)
+{
+	task **link = &crt_OS.sleepList;
+
+	while(*link != NULL && *link != task_sleep)
+		link = &(*link)->nextSleep;
+
+	if(*link != NULL)
+		*link = task_sleep->nextSleep;
+
+	task_sleep->nextSleep = NULL;
+	task_sleep->sleeping = false;
+}
+
+/*************************************************************************************************
+	 *  @brief Quita una tarea de la lista de espera en la que se encuentra
+     *
+     *  @details
+     *   Debe llamarse dentro de una sección crítica.
+     *
+	 *  @param task_wait	Tarea a quitar.
+	 *  @return none.
+***************************************************************************************************/
+OS_RAMFUNC static void removeWaiting(task *task_wait)
+{
+	task **link = task_wait->waitList;
+
+	while(*link != NULL && *link != task_wait)
+		link = &(*link)->nextWait;
+
+	if(*link != NULL)
+		*link = task_wait->nextWait;
+
+	task_wait->nextWait = NULL;
+	task_wait->waitList = NULL;
+}
+
+/*************************************************************************************************
+	 *  @brief Función que getCurrentTaskOS
+     *
+     *  @details
+	 *  Función que devuelve como parametro la tarea actual del sistema
+     *
+	 *  @param none
+	 *  @return task Tarea actual en el sistema de control del OS
+***************************************************************************************************/
+task* getCurrentTask(void)
+{
+	return crt_OS.current_task;
+}
+
+/*************************************************************************************************
+	 *  @brief Forzado de Scheduling (Llama al scheduler y a cambio de contexto si es necesario)
+     *
+     *  @details
+     *  Función que llama al scheuler y al cambio de contexto si es necesario
+     *  llama a la funcion scheuler y reviza la bandera de cambio de contexto y llama a la
+     *  interupcion PENDSVSET para realizar cambio de contexto si es necesario.
+     *
+	 *  @param 		None
+	 *  @return     None.
+***************************************************************************************************/
+OS_RAMFUNC void osForceSchCC(void){
+	/*
+	 * El scheduler se ejecuta dentro de una sección crítica para que el SysTick no lo
+	 * interrumpa a mitad de la decisión y fuerce un cambio de contexto con el OS en
+	 * estado SCHEDULING
+	 */
+	osEnterCritical();
+	scheduler();
+	osExitCritical();
+	if(crt_OS.contexSwitch)
+	{
+		/**
+		 * Se pide el cambio de contexto al port (excepcion PendSV en Cortex-M)
+		 */
+		portTriggerContextSwitch();
+	}
+}
+
+/*************************************************************************************************
+	 *  @brief Funcion que efectua las decisiones de scheduling.
+     *
+     *  @details
+     *
+     *   La función contiene el scheduler que determinar la siguiente tarea que se va a ejecutar
+     *   verificando el estado del OS.
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+OS_RAMFUNC OS_INTERNAL void scheduler(void) {
+
+	static uint8_t priorityIndex[PRIORITY_SIZE];
+	uint8_t blockedTasks[PRIORITY_SIZE];
+
+	uint8_t i = 0;
+	uint8_t priority = PRIORITY_MAX;
+	uint8_t priorityAux = PRIORITY_MAX;
+
+	uint8_t indexTask = 0;
+
+	bool flag = true;
+
+	bool priorityChange = false;
+
+	/*
+	 * Se cuenta con un vector (priorityIndex) que contiene los indices para recorrer cada uno de los
+	 * vectores de las prioridades alojados en el vector bidimencional (taskPriority)
+	 *
+	 * Se cuenta también con un vector (blockedTasks) se clarea cada vez que entra al scheduler
+	 * y que contiene el número de tareas bloqueadas en cada uno de los vectores de prioridad.
+	 *
+	 * Se tiene una variable priority que sirve para recorrer el primer campo (campo de prioridades) del vector
+	 * bidimencional (taskPriority), este incrementa cada vez que el algoritmo verifica que todas las tareas
+	 * de una prioridad mayor estan bloqueadas
+	 *
+	 * La variable indexTask se utiliza como índice temporal para recorrer las tareas en los
+	 * vectores de las prioridades
+	 *
+	 * La bandera (flag) sirve para verificar si se debe salir o no del blucle de verificación de prioridades.
+	 *
+	 * La bandera (priorityChange) sirve para verificar si hubo un cambio de prioridad realizar las comparaciones
+	 * con la prioridad anterior
+	 *
+	 * Primero se verifica si el estado del Sistema Operativo es después de un Reset, si viene de un reset
+	 * la tarea actual se carga con la tarea Idle del OS.
+	 *
+	 * Se clarea el tambien el vector (priorityIndex).
+	 *
+	 */
+
+	if(crt_OS.state == FROM_RESET){
+		crt_OS.current_task = &g_idleTask;
+		crt_OS.contexSwitch = true;
+
+		for(i=0; i < PRIORITY_SIZE; i++)
+			priorityIndex[i] = 0;
+	}
+	else {
+
+		/**
+		 * Se verifica el estado del control del OS, si se encuentra en estado SCHEDULING no se
+		 * ejecuta el algoritmo y la función retorna.
+		 * Se realiza en este parte de la función porque siempre entra a este apartado
+		 * deferente de cuando viene de RESET.
+		 */
+		if(crt_OS.state == SCHEDULING)
 			return;
 
 		/**
@@ -577,6 +1390,32 @@ static void scheduler(void) {
 		 * el algoritmo cuando se realizó el llamado en otro lado diferente al sistick
 		 */
 		crt_OS.state = SCHEDULING;
+
+#if JAMMOS_SCHED_TT
+		/*
+		 * Con una tabla instalada la tarea del marco menor actual tiene precedencia, el resto
+		 * de las políticas solo eligen tareas en el tiempo libre del marco
+		 */
+		if(crt_OS.ttTable != NULL && schedulerTt())  {
+			if(crt_OS.contexSwitch)
+				OS_TRACE(TRACE_SCHEDULE, crt_OS.next_task->id);
+			crt_OS.state = NORMAL_RUN;
+			return;
+		}
+#endif
+#if JAMMOS_SCHED_EDF
+		/*
+		 * Con la política EDF primero se busca la tarea periódica lista con el deadline más
+		 * próximo, las tareas no periódicas se eligen con el algoritmo de prioridades solo si
+		 * ninguna tarea periódica está lista
+		 */
+		if(schedulerEdf())  {
+			if(crt_OS.contexSwitch)
+				OS_TRACE(TRACE_SCHEDULE, crt_OS.next_task->id);
+			crt_OS.state = NORMAL_RUN;
+			return;
+		}
+#endif
 		/*
 		 * Cuando el estado del sistema es diferente al proveniente de un Reset se clarean los contadores
 		 * de las tareas bloqueadas en todos los niveles.
@@ -598,6 +1437,21 @@ static void scheduler(void) {
 			 * a que tarea asignar la tarea siguiente.
 			 */
 
+			/*
+			 * Si no hay tareas con la prioridad actual (por ejemplo porque se eliminaron en tiempo
+			 * de ejecución) se pasa directamente a la siguiente prioridad
+			 */
+			if(crt_OS.countPriority[priority] == 0)
+			{
+				priority++;
+				if(priority > PRIORITY_MIN){
+					crt_OS.next_task = &g_idleTask;
+					crt_OS.contexSwitch = true;
+					flag = false;
+				}
+				continue;
+			}
+
 			indexTask = priorityIndex[priority];
 
 			if(indexTask >= crt_OS.countPriority[priority])
@@ -676,9 +1530,147 @@ static void scheduler(void) {
             if(priorityIndex[priorityAux] >= crt_OS.countPriority[priorityAux])
 				priorityIndex[priorityAux] = 0;
 		}
+
+		/*
+		 * Umbral de desalojo: la tarea en ejecución con un umbral menor a su prioridad solo es
+		 * desalojada por una tarea de prioridad mayor que el umbral
+		 */
+		if(crt_OS.contexSwitch && crt_OS.current_task->state == RUNNING &&
+				crt_OS.current_task->threshold < crt_OS.current_task->priority &&
+				crt_OS.next_task->priority >= crt_OS.current_task->threshold)
+			crt_OS.contexSwitch = false;
+
+		if(crt_OS.contexSwitch)
+			OS_TRACE(TRACE_SCHEDULE, crt_OS.next_task->id);
+
+		/*
+		 * Desde un reset el estado se mantiene en FROM_RESET hasta el primer cambio de contexto,
+		 * getNextContext lo utiliza para no guardar el contexto de main en la tarea Idle
+		 */
+		crt_OS.state = NORMAL_RUN;
+	}
+}
+
+#if JAMMOS_SCHED_EDF
+/*************************************************************************************************
+	 *  @brief Política earliest deadline first
+     *
+     *  @details
+     *   Recorre la lista de tareas y elige, entre las tareas periódicas en estado READY o
+     *   RUNNING, la de deadline absoluto más próximo. Ante deadlines iguales se mantiene la
+     *   tarea en ejecución para no realizar cambios de contexto innecesarios, y si no está en
+     *   ejecución se elige la de mayor prioridad. La cantidad de tareas está acotada por
+     *   MAX_TASK_NUMBER, por lo que el recorrido lineal es más barato que mantener una
+     *   estructura ordenada en cada cambio de estado de las tareas.
+     *
+	 *  @param 		None.
+	 *  @return     true si se eligió una tarea periódica.
+***************************************************************************************************/
+OS_RAMFUNC static bool schedulerEdf(void)
+{
+	task *edfTask = NULL;
+	task *candidate;
+	int32_t diff;
+	uint8_t i;
+
+	for(i = 0; i < crt_OS.quantity_task; i++)
+	{
+		candidate = crt_OS.taskList[i];
+
+		if(candidate->relDeadline == 0 || (candidate->state != READY && candidate->state != RUNNING))
+			continue;
+
+		if(edfTask == NULL)  {
+			edfTask = candidate;
+			continue;
+		}
+
+		diff = (int32_t)(candidate->deadline - edfTask->deadline);
+		if(diff < 0 || (diff == 0 && (candidate->state == RUNNING ||
+				(edfTask->state != RUNNING && candidate->priority < edfTask->priority))))
+			edfTask = candidate;
+	}
+
+	if(edfTask == NULL)
+		return false;
+
+	if(edfTask->state == RUNNING)
+		crt_OS.contexSwitch = false;
+	else  {
+		crt_OS.next_task = edfTask;
+		crt_OS.contexSwitch = true;
+	}
+
+	return true;
+}
+#endif
+
+#if JAMMOS_SCHED_TT
+/*************************************************************************************************
+	 *  @brief Despacho de los marcos del ejecutivo cíclico
+     *
+     *  @details
+     *   Se llama en cada tick desde el handler de SysTick. Al inicio de cada marco menor cuenta
+     *   como excedido el marco anterior si su tarea no terminó el trabajo, y libera la tarea
+     *   del nuevo marco. El costo es constante: no depende de la cantidad de tareas ni del
+     *   tamaño de la tabla.
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+OS_RAMFUNC static void dispatchFrame(void)
+{
+	const ttSchedule *table = crt_OS.ttTable;
+	task *slotTask;
+
+	if(--crt_OS.ttTicksLeft != 0)
+		return;
+
+	crt_OS.ttTicksLeft = table->minorTicks;
+
+	if(crt_OS.ttTask != NULL && !crt_OS.ttTask->ttWaiting)  {
+		crt_OS.ttOverruns++;
+		frameOverrunHook(crt_OS.ttTask);
+	}
+
+	slotTask = table->slots[crt_OS.ttFrame];
+	if(++crt_OS.ttFrame >= table->minorFrames)
+		crt_OS.ttFrame = 0;
+
+	crt_OS.ttTask = slotTask;
+	if(slotTask != NULL && slotTask->ttWaiting)  {
+		slotTask->ttWaiting = false;
+		slotTask->state = READY;
+	}
+}
+
+/*************************************************************************************************
+	 *  @brief Política time-triggered
+     *
+     *  @details
+     *   Elige la tarea del marco menor actual si todavía no terminó su trabajo y no está
+     *   bloqueada en una cola, semáforo u osDelay.
+     *
+	 *  @param 		None.
+	 *  @return     true si se eligió la tarea del marco.
+***************************************************************************************************/
+OS_RAMFUNC static bool schedulerTt(void)
+{
+	task *slotTask = crt_OS.ttTask;
+
+	if(slotTask == NULL || (slotTask->state != READY && slotTask->state != RUNNING))
+		return false;
+
+	if(slotTask->state == RUNNING)
+		crt_OS.contexSwitch = false;
+	else  {
+		crt_OS.next_task = slotTask;
+		crt_OS.contexSwitch = true;
 	}
-	crt_OS.state = NORMAL_RUN;
+
+	return true;
 }
+#endif
 
 /*************************************************************************************************
 	 *  @brief SysTick Handler.
@@ -691,24 +1683,58 @@ static void scheduler(void) {
 	 *  @param 		None.
 	 *  @return     None.
 ***************************************************************************************************/
-void SysTick_Handler(void)  {
+OS_RAMFUNC void SysTick_Handler(void)  {
+
+	task *sleepTask;
+
+	OS_TRACE(TRACE_TICK, 0);
 
-	int i = 0;
+#if JAMMOS_BUDGET
 	/*
-	 * Se realiza un recorrido por todas las tareas decrementando la variable de conteo
-	 * del timer para la función delay
-	 * Verificación de que las tareas con determinado indice que están bloqueadas y han llegado a
-	 * su contadores de ticksTimer a cero se cambia a estado READY
+	 * Se descuenta del presupuesto de la tarea en ejecución el tiempo desde el último descuento,
+	 * así una tarea que no cede el CPU se suspende a lo sumo un tick después de agotarlo
 	 */
-	for(i = 0; i < crt_OS.quantity_task; i++)
+	if(crt_OS.state != FROM_RESET)
+		chargeBudget(crt_OS.current_task, portGetCycles());
+#endif
+	/*
+	 * Se incrementa el contador de ticks del OS y se pasan a READY las tareas dormidas cuyo
+	 * tick de despertar se alcanzó
+	 */
+	crt_OS.tickCount++;
+
+	/*
+	 * La lista de tareas dormidas está ordenada por tick de despertar, solo se recorren las
+	 * tareas que despiertan en este tick
+	 */
+	while(crt_OS.sleepList != NULL && (int32_t)(crt_OS.sleepList->wakeTick - (uint32_t)crt_OS.tickCount) <= 0)
 	{
-		if(crt_OS.taskList[i]->ticksWaiting > 0)
-			crt_OS.taskList[i]->ticksWaiting--;
+		sleepTask = crt_OS.sleepList;
+		crt_OS.sleepList = sleepTask->nextSleep;
+		sleepTask->nextSleep = NULL;
+		sleepTask->sleeping = false;
+
+		/*
+		 * Si la tarea esperaba un evento con timeout, el timeout venció
+		 */
+		if(sleepTask->waitList != NULL)  {
+			removeWaiting(sleepTask);
+			sleepTask->waitTimeout = true;
+		}
 
-		if(crt_OS.taskList[i]->ticksWaiting == 0 && crt_OS.taskList[i]->state == BLOCKED)
-			crt_OS.taskList[i]->state = READY;
+		if(sleepTask->state == BLOCKED)
+			sleepTask->state = READY;
 	}
 
+#if JAMMOS_BUDGET
+	if(crt_OS.budgetTasks > 0)
+		replenishBudgets();
+#endif
+#if JAMMOS_SCHED_TT
+	if(crt_OS.ttTable != NULL)
+		dispatchFrame();
+#endif
+
 	/*
 	 * Dentro del SysTick handler se llama al scheduler. Separar el scheduler de
 	 * getContextoSiguiente da libertad para cambiar la politica de scheduling en cualquier
@@ -726,21 +1752,9 @@ void SysTick_Handler(void)  {
 
 	if(crt_OS.contexSwitch){
 		/**
-		 * Se setea el bit correspondiente a la excepcion PendSV
-		 */
-		SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
-
-		/**
-		 * Instruction Synchronization Barrier; flushes the pipeline and ensures that
-		 * all previous instructions are completed before executing new instructions
+		 * Se pide el cambio de contexto al port (excepcion PendSV en Cortex-M)
 		 */
-		__ISB();
-
-		/**
-		 * Data Synchronization Barrier; ensures that all memory accesses are
-		 * completed before next instruction is executed
-		 */
-		__DSB();
+		portTriggerContextSwitch();
 	}
 }
 
@@ -756,8 +1770,11 @@ void SysTick_Handler(void)  {
 	 *  			que la funcion es invocada.
 	 *  @return     El valor a cargar en MSP para apuntar al contexto de la tarea siguiente.
 ***************************************************************************************************/
-uint32_t getNextContext(uint32_t sp_current)  {
-	uint32_t sp_next;
+OS_RAMFUNC uintptr_t getNextContext(uintptr_t sp_current)  {
+	uintptr_t sp_next;
+#if JAMMOS_CPU_USAGE
+	uint32_t cycles;
+#endif
 
 
 	/*
@@ -770,6 +1787,13 @@ uint32_t getNextContext(uint32_t sp_current)  {
 		sp_next = crt_OS.current_task->stack_pointer;
 		crt_OS.current_task->state = RUNNING;
 		crt_OS.state = NORMAL_RUN;
+#if JAMMOS_CPU_USAGE
+		crt_OS.lastSwitchCycles = portGetCycles();
+		crt_OS.windowStartCycles = crt_OS.lastSwitchCycles;
+#endif
+#if JAMMOS_BUDGET
+		crt_OS.lastChargeCycles = portGetCycles();
+#endif
 	}
 
 	/*
@@ -782,16 +1806,279 @@ uint32_t getNextContext(uint32_t sp_current)  {
 	else {
 		crt_OS.current_task->stack_pointer = sp_current;
 
+#if JAMMOS_CPU_USAGE
+		/*
+		 * Se cargan a la tarea saliente los ciclos que estuvo en ejecución desde el último
+		 * cambio de contexto. La resta sin signo es válida aunque el contador haya desbordado
+		 */
+		cycles = portGetCycles();
+		crt_OS.current_task->cpuCycles += cycles - crt_OS.lastSwitchCycles;
+		crt_OS.lastSwitchCycles = cycles;
+#endif
+#if JAMMOS_BUDGET
+		/*
+		 * Se descuenta el presupuesto de la tarea saliente, si lo agotó queda suspendida
+		 */
+		chargeBudget(crt_OS.current_task, portGetCycles());
+#endif
+
 		if (crt_OS.current_task->state == RUNNING)
 			crt_OS.current_task->state = READY;
 
 		sp_next = crt_OS.next_task->stack_pointer;
 
+		OS_TRACE(TRACE_SWITCH, crt_OS.next_task->id);
+		crt_OS.contextSwitches++;
+
 		crt_OS.current_task = crt_OS.next_task;
 		crt_OS.current_task->state = RUNNING;
+
+		/*
+		 * Si la tarea saliente se eliminó a si misma, ya no se utiliza su stack y
+		 * su bloque puede devolverse al pool de tareas
+		 */
+		if(crt_OS.deletedTask != NULL && crt_OS.deletedTask != crt_OS.current_task)  {
+			if(osPoolContains(&taskPool, crt_OS.deletedTask))
+				osPoolFree(&taskPool, crt_OS.deletedTask);
+			crt_OS.deletedTask = NULL;
+		}
 	}
 
 	crt_OS.contexSwitch = false;
 
 	return sp_next;
 }
+
+#if JAMMOS_CPU_USAGE
+/*************************************************************************************************
+	 *  @brief Obtiene el uso de CPU de cada tarea.
+     *
+     *  @details
+     *   Calcula el porcentaje de CPU que utilizó cada tarea y la tarea idle desde la medición
+     *   anterior y comienza una nueva ventana de medición. El cálculo se hace dentro de una
+     *   sección crítica para que ningún cambio de contexto altere los contadores.
+     *
+	 *  @param 		usage	Estructura donde se copia la medición.
+	 *  @return     None.
+	 *
+	 *  @warning	El contador de ciclos es de 32 bits, la ventana entre dos mediciones debe ser
+	 *  			menor a 2^32 ciclos (21 segundos a 204 MHz).
+***************************************************************************************************/
+void osGetCpuUsage(cpuUsage *usage)
+{
+	uint32_t cycles;
+	uint8_t i;
+
+	osEnterCritical();
+
+	/*
+	 * Se cargan a la tarea actual los ciclos que lleva en ejecución
+	 */
+	cycles = portGetCycles();
+	crt_OS.current_task->cpuCycles += cycles - crt_OS.lastSwitchCycles;
+	crt_OS.lastSwitchCycles = cycles;
+
+	usage->windowCycles = cycles - crt_OS.windowStartCycles;
+	crt_OS.windowStartCycles = cycles;
+	usage->quantity_task = crt_OS.quantity_task;
+
+	for(i = 0; i < crt_OS.quantity_task; i++)  {
+		usage->id[i] = crt_OS.taskList[i]->id;
+		usage->usage[i] = usage->windowCycles == 0 ? 0 :
+				(uint16_t)(((uint64_t)crt_OS.taskList[i]->cpuCycles * CPU_USAGE_SCALE) / usage->windowCycles);
+		crt_OS.taskList[i]->cpuCycles = 0;
+	}
+
+	usage->idle = usage->windowCycles == 0 ? 0 :
+			(uint16_t)(((uint64_t)g_idleTask.cpuCycles * CPU_USAGE_SCALE) / usage->windowCycles);
+	g_idleTask.cpuCycles = 0;
+
+	osExitCritical();
+}
+#endif
+
+#if JAMMOS_BUDGET
+/*************************************************************************************************
+	 *  @brief Asigna un presupuesto de ejecución a una tarea
+     *
+     *  @details
+     *   La tarea puede ejecutar a lo sumo budgetUs microsegundos de CPU en cada período de
+     *   reposición de periodTicks ticks. El tiempo se descuenta con el contador de ciclos del
+     *   port en cada cambio de contexto y en cada tick, e incluye el tiempo de las
+     *   interrupciones que la desalojan. Si la tarea agota su presupuesto se suspende hasta la
+     *   próxima reposición y se llama a budgetOverrunHook, de esta forma una tarea de alta
+     *   prioridad que no cede el CPU no impide la ejecución de las de menor prioridad.
+     *
+	 *  @param task_budget		Tarea a limitar.
+	 *  @param budgetUs			Presupuesto en microsegundos por período, 0 para quitar el límite.
+	 *  @param periodTicks		Período de reposición en ticks.
+	 *  @return none.
+***************************************************************************************************/
+void osSetTaskBudget(task *task_budget, uint32_t budgetUs, uint32_t periodTicks)
+{
+	uint64_t cycles = ((uint64_t)budgetUs * portCpuFrequency()) / 1000000;
+
+	if(budgetUs != 0 && periodTicks == 0)  {
+		crt_OS.err = ERR_OS_BUDGET;
+		errorHook(osSetTaskBudget);
+		return;
+	}
+
+	osEnterCritical();
+
+	if(task_budget->budget == 0 && budgetUs != 0)
+		crt_OS.budgetTasks++;
+	else if(task_budget->budget != 0 && budgetUs == 0)
+		crt_OS.budgetTasks--;
+
+	task_budget->budget = budgetUs == 0 ? 0 : (cycles > UINT32_MAX ? UINT32_MAX : (cycles == 0 ? 1 : (uint32_t)cycles));
+	task_budget->budgetPeriod = periodTicks;
+	task_budget->budgetTick = (uint32_t)crt_OS.tickCount + periodTicks;
+	task_budget->budgetUsed = 0;
+	task_budget->budgetMaxUsed = 0;
+	task_budget->budgetOverruns = 0;
+	task_budget->budgetOverrun = false;
+
+	if(task_budget->budgetSuspended)  {
+		task_budget->budgetSuspended = false;
+		task_budget->state = READY;
+	}
+
+	osExitCritical();
+}
+
+/*************************************************************************************************
+	 *  @brief Devuelve las estadísticas del presupuesto de ejecución de una tarea
+     *
+	 *  @param task_budget		Tarea consultada.
+	 *  @param stats			Estructura donde se copian las estadísticas.
+	 *  @return true si la tarea tiene presupuesto asignado.
+***************************************************************************************************/
+bool osGetBudgetStats(task *task_budget, budgetStats *stats)
+{
+	osEnterCritical();
+	stats->budgetCycles = task_budget->budget;
+	stats->usedCycles = task_budget->budgetUsed;
+	stats->maxUsedCycles = task_budget->budgetMaxUsed;
+	stats->overruns = task_budget->budgetOverruns;
+	stats->suspended = task_budget->budgetSuspended;
+	osExitCritical();
+
+	return task_budget->budget != 0;
+}
+
+/*************************************************************************************************
+	 *  @brief Descuenta del presupuesto de una tarea el tiempo ejecutado
+     *
+     *  @details
+     *   Descuenta los ciclos transcurridos desde el último descuento. Si la tarea superó su
+     *   presupuesto y no está bloqueada se suspende: queda BLOCKED fuera de toda lista hasta la
+     *   reposición. Una tarea que agotó el presupuesto mientras esperaba un evento se suspende
+     *   en el primer descuento luego de despertar. Se llama desde SysTick_Handler y
+     *   getNextContext.
+     *
+	 *  @param task_charge		Tarea a la que se descuenta el tiempo (la tarea en ejecución).
+	 *  @param cycles			Contador de ciclos actual.
+	 *  @return none.
+***************************************************************************************************/
+OS_RAMFUNC static void chargeBudget(task *task_charge, uint32_t cycles)
+{
+	uint32_t elapsed = cycles - crt_OS.lastChargeCycles;
+
+	crt_OS.lastChargeCycles = cycles;
+
+	if(task_charge->budget == 0)
+		return;
+
+	task_charge->budgetUsed += elapsed;
+	if(task_charge->budgetUsed > task_charge->budgetMaxUsed)
+		task_charge->budgetMaxUsed = task_charge->budgetUsed;
+
+	if(task_charge->budgetUsed <= task_charge->budget)
+		return;
+
+	if(task_charge->state != BLOCKED)  {
+		task_charge->state = BLOCKED;
+		task_charge->budgetSuspended = true;
+	}
+
+	if(!task_charge->budgetOverrun)  {
+		task_charge->budgetOverrun = true;
+		task_charge->budgetOverruns++;
+		budgetOverrunHook(task_charge);
+	}
+}
+
+/*************************************************************************************************
+	 *  @brief Repone los presupuestos cuyo período venció
+     *
+     *  @details
+     *   Se llama en cada tick si hay tareas con presupuesto. Las tareas suspendidas por agotar
+     *   su presupuesto vuelven a READY.
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+OS_RAMFUNC static void replenishBudgets(void)
+{
+	task *budgetTask;
+	uint8_t i;
+
+	for(i = 0; i < crt_OS.quantity_task; i++)
+	{
+		budgetTask = crt_OS.taskList[i];
+
+		if(budgetTask->budget == 0 || (int32_t)((uint32_t)crt_OS.tickCount - budgetTask->budgetTick) < 0)
+			continue;
+
+		budgetTask->budgetTick += budgetTask->budgetPeriod;
+		budgetTask->budgetUsed = 0;
+		budgetTask->budgetOverrun = false;
+
+		if(budgetTask->budgetSuspended)  {
+			budgetTask->budgetSuspended = false;
+			budgetTask->state = READY;
+		}
+	}
+}
+#endif
+
+#ifdef JAMMOS_TEST
+/*************************************************************************************************
+	 *  @brief Reinicia el estado del OS (solo compilación de prueba)
+     *
+     *  @details
+     *   Borra la estructura de control y la tarea idle para que el harness pueda armar una
+     *   nueva configuración de tareas con osInitTask y osInit dentro del mismo proceso.
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+void osTestReset(void)
+{
+	memset(&crt_OS, 0, sizeof(crt_OS));
+	memset(&g_idleTask, 0, sizeof(g_idleTask));
+}
+
+/*************************************************************************************************
+	 *  @brief Devuelve la estructura de control del OS (solo compilación de prueba)
+     *
+	 *  @param 		None.
+	 *  @return     Puntero a crt_OS.
+***************************************************************************************************/
+osCrt* osTestGetControl(void)
+{
+	return &crt_OS;
+}
+
+/*************************************************************************************************
+	 *  @brief Devuelve la tarea idle (solo compilación de prueba)
+     *
+	 *  @param 		None.
+	 *  @return     Puntero a g_idleTask.
+***************************************************************************************************/
+task* osTestGetIdleTask(void)
+{
+	return &g_idleTask;
+}
+#endif
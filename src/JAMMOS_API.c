@@ -6,12 +6,16 @@
  */
 
 #include "JAMMOS_API.h"
+#include "JAMMOS_SET.h"
+#include "JAMMOS_TRACE.h"
+#include <string.h>
 
 /*************************************************************************************************
 	 *  @brief función de retraso
      *
      *  @details
-     *   Esta función funciona a referencia de los ticks del sistema
+     *   Esta función funciona a referencia de los ticks del sistema. La tarea duerme hasta el
+     *   tick actual más ticks, por lo que el retraso es relativo al momento de la llamada.
      *
 	 *  @param ticks de retraso del sistema, 1 milisegundo
 	 *
@@ -19,131 +23,345 @@
 ***************************************************************************************************/
 void osDelay(uint32_t ticks)
 {
-	task* currentTask;
 	/*
 	 * Verifica que el numero de ticks ingresados es mayor que cero
 	 * para realizar el delay en caso contrario no realiza nada
 	 * */
 	if(ticks > 0)
 	{
-		osEnterCritical();
-		/*
-		 * Obtiene la tarea actual que tiene el control del sistema
-		 * se utiliza una función getCurrentTask
-		 * */
-		currentTask = getCurrentTask();
-		/*
-		 * linea que configura los tickstimer de la tarea actual con el
-		 * valor ingresado por el parametro proveniente desde la tarea
-		 * */
-		currentTask->ticksWaiting = ticks;
+		OS_TRACE(TRACE_DELAY, ticks);
+		osSleepUntil(osGetTickCount() + ticks);
+	}
+}
 
-		osExitCritical();
-		/*
-		 * Se verifica que el estado de la tarea actual esté conrriendo para
-		 * poder ser bloqueda, en caso distinto no se realiza nada
-		 * */
-		if(currentTask->state == RUNNING)
-		{
-			/*
-			 * Si por algún motivo el contro del cpu vuelve a la tarea se verifica que
-			 * los ticks del timer aun no han espirado y vuelve a bloaquear la tarea y
-			 * a forzar un scheuler y cambio de contexto si es necesario
-			 * */
-			while(currentTask->ticksWaiting > 0)
-			{
-				currentTask->state = BLOCKED;
-				osForceSchCC();
-			}
-		}
+/*************************************************************************************************
+	 *  @brief función de retraso periódico
+     *
+     *  @details
+     *   Duerme la tarea hasta el tick *lastWakeTick + period y actualiza *lastWakeTick con ese
+     *   valor. Como el despertar se calcula desde el despertar anterior y no desde el momento de
+     *   la llamada, una tarea periódica no acumula la deriva de su tiempo de ejecución ni de la
+     *   latencia del scheduling. *lastWakeTick se inicializa con osGetTickCount() antes del
+     *   primer llamado.
+     *
+     *   Si el tick de despertar ya pasó (la tarea excedió su período) la función retorna sin
+     *   bloquear, sin intentar recuperar los períodos perdidos.
+     *
+	 *  @param lastWakeTick, tick del despertar anterior, se actualiza con el nuevo despertar
+	 *  @param period, período de la tarea en ticks
+	 *
+	 *  @return true si la tarea durmió, false si el período ya había vencido.
+***************************************************************************************************/
+bool osDelayUntil(uint32_t *lastWakeTick, uint32_t period)
+{
+	uint32_t wakeTick = *lastWakeTick + period;
+	bool delayed;
+
+	*lastWakeTick = wakeTick;
+	delayed = (int32_t)(wakeTick - osGetTickCount()) > 0;
+
+	if(delayed)
+	{
+		OS_TRACE(TRACE_DELAY, period);
+		osSleepUntil(wakeTick);
 	}
+
+	return delayed;
+}
+
+/*************************************************************************************************
+	 *  @brief Ticks restantes de una espera con timeout
+     *
+     *  @details
+     *   Las APIs bloqueantes pueden despertar por el evento y encontrar el objeto ocupado
+     *   nuevamente por otra tarea, en ese caso vuelven a esperar solo el tiempo restante hasta
+     *   el tick límite calculado al inicio de la llamada.
+     *
+	 *  @param timeout, timeout original de la llamada
+	 *  @param deadline, tick límite de la espera
+	 *  @return ticks restantes, OS_WAIT_FOREVER u OS_NO_WAIT si el tiempo ya venció.
+***************************************************************************************************/
+static uint32_t waitRemaining(uint32_t timeout, uint32_t deadline)
+{
+	int32_t remaining;
+
+	if(timeout == OS_WAIT_FOREVER)
+		return OS_WAIT_FOREVER;
+
+	remaining = (int32_t)(deadline - osGetTickCount());
+
+	return remaining > 0 ? (uint32_t)remaining : OS_NO_WAIT;
 }
 
 /*************************************************************************************************
 	 *  @brief función inicialicación de un semáforo
      *
      *  @details
-     *   Esta función inicializa el semáforo con la tarea null e inicializa el semáforo tomado
+     *   Esta función inicializa el semáforo sin tareas en espera e inicializa el semáforo tomado
      *
 	 *  @param semáforo que se va a inicializar
 	 *  @return none.
 ***************************************************************************************************/
 void osInitSemaphore(semaphore *sem)
 {
-	sem->semaphoreTask = NULL;
+	sem->waitList = NULL;
 	sem->state = TAKEN;
+	sem->setWaitList = NULL;
 }
 
 /*************************************************************************************************
 	 *  @brief función de liberación de un semáforo
      *
      *  @details
-     *   Esta libera el semáforo de entrada de parametro verificando que tenga tarea asociada y
-     *   que se encuentre tomado, también se verifica que la tarea actual esté en estado RUNNING
+     *   Esta libera el semáforo de entrada de parametro verificando que se encuentre tomado.
+     *   Si hay tareas bloqueadas en el semáforo se pasa a READY la de mayor prioridad; si no
+     *   las hay el semáforo queda liberado para la próxima llamada a osTakeSemaphore. Desde una
+     *   interrupción se pide el scheduling a la salida del handler si se despertó una tarea.
      *
 	 *  @param semáforo que se libera
 	 *  @return none.
 ***************************************************************************************************/
 void osGiveSemaphore(semaphore *sem)
 {
-	task* currentTask;
-	if(sem->semaphoreTask != NULL && sem->state == TAKEN)
+	osEnterCritical();
+	if(sem->state == TAKEN)
 	{
-		osEnterCritical();
-		currentTask = getCurrentTask();
-		if(currentTask->state == RUNNING)
-		{
-			sem->state = RELEASED;
-			sem->semaphoreTask = READY;
-		}
-		osExitCritical();
+		sem->state = RELEASED;
+		if((osSignalEvent(&sem->waitList) || osSignalSet(sem->setWaitList)) &&
+				osGetSytemState() == RUN_IRQ)
+			osSetScheduleFromISR(true);
+		OS_TRACE(TRACE_SEM_GIVE, sem);
 	}
+	osExitCritical();
 }
 
 /*************************************************************************************************
 	 *  @brief función tomar un semáforo
      *
      *  @details
-     *   Esta función verifica si el semáforo está tomado, si es así,
-     *   asigna la tarea asociada del semaforo con la tarea actual y la bloquea
-     *   llamando luego a la función que realiza el scheduler y el llamado a
-     *   contexto si se necesita.
+     *   Esta función verifica si el semáforo está tomado, si es así, bloquea la tarea actual
+     *   en la lista de espera del semáforo hasta que se llame a osGiveSemaphore o venza el
+     *   timeout. Desde una interrupción solo puede usarse con timeout OS_NO_WAIT.
      *
 	 *  @param sem semáforo que se toma
-	 *  @return none.
+	 *  @param timeout ticks de espera máxima, OS_WAIT_FOREVER u OS_NO_WAIT
+	 *  @return true si se tomó el semáforo, false si venció el timeout.
 ***************************************************************************************************/
-void osTakeSemaphore(semaphore *sem)
+bool osTakeSemaphore(semaphore *sem, uint32_t timeout)
 {
-	bool isTaken = true;
+	uint32_t deadline = osGetTickCount() + timeout;
+	bool taken = false;
 
 	/*
-	 * Este while evita que la tarea se ejecute a no se de que se haga un llamado
-	 * a la función Give con el semáforo correspondiente
+	 * El estado se verifica dentro de la sección crítica para que un Give desde una
+	 * interrupción no se pierda entre la verificación y el bloqueo de la tarea. Si al
+	 * despertar otra tarea tomó el semáforo primero se vuelve a esperar el tiempo restante
 	 */
-	while(isTaken)
+	osEnterCritical();
+	while(!taken)
 	{
-		if(sem->state == TAKEN)
+		if(sem->state == RELEASED)
 		{
-			osEnterCritical();
-			sem->semaphoreTask = getCurrentTask();
-			sem->semaphoreTask->state = BLOCKED;
-			osExitCritical();
-			osForceSchCC();
+			sem->state = TAKEN;
+			taken = true;
 		}
 		else
 		{
-			sem->state = TAKEN;
-			isTaken = false;
+			OS_TRACE(TRACE_SEM_BLOCK, sem);
+			if(!osWaitEvent(&sem->waitList, waitRemaining(timeout, deadline)))
+				break;
 		}
 	}
+	osExitCritical();
+
+	if(taken)
+		OS_TRACE(TRACE_SEM_TAKE, sem);
+	else
+		OS_TRACE(TRACE_TIMEOUT, sem);
+
+	return taken;
+}
+
+/*************************************************************************************************
+	 *  @brief Entrega el lock a las tareas lectoras que esperan
+     *
+     *  @details
+     *   Pasa a READY todas las lectoras en espera y las cuenta como dueñas del lock, de modo que
+     *   al despertar no compiten con nuevas escritoras. Debe llamarse dentro de una sección
+     *   crítica, sin escritora dueña del lock.
+     *
+	 *  @param lock, lock de lectura/escritura
+	 *  @return true si se despertó alguna tarea.
+***************************************************************************************************/
+static bool grantReaders(rwLock *lock)
+{
+	uint8_t woken = osBroadcastEvent(&lock->readWaitList);
+
+	lock->readers += woken;
+
+	return woken > 0;
+}
+
+/*************************************************************************************************
+	 *  @brief Entrega el lock a la tarea escritora de mayor prioridad que espera
+     *
+     *  @details
+     *   Debe llamarse dentro de una sección crítica, sin lectoras ni escritora dueñas del lock.
+     *
+	 *  @param lock, lock de lectura/escritura
+	 *  @return true si se despertó una tarea.
+***************************************************************************************************/
+static bool grantWriter(rwLock *lock)
+{
+	if(lock->writeWaitList == NULL)
+		return false;
+
+	lock->writer = true;
+	return osSignalEvent(&lock->writeWaitList);
+}
+
+/*************************************************************************************************
+	 *  @brief función de inicialización de un lock de lectura/escritura
+     *
+	 *  @param lock, lock que se va a inicializar libre
+	 *  @return none.
+***************************************************************************************************/
+void osInitRwLock(rwLock *lock)
+{
+	lock->readers = 0;
+	lock->writer = false;
+	lock->readWaitList = NULL;
+	lock->writeWaitList = NULL;
+}
+
+/*************************************************************************************************
+	 *  @brief función que toma un lock de lectura/escritura para lectura
+     *
+     *  @details
+     *   Varias tareas pueden leer a la vez. Si una escritora tiene el lock o espera tomarlo la
+     *   tarea se bloquea hasta que se le entregue el lock o venza el timeout, por lo que un
+     *   flujo continuo de lectoras no demora indefinidamente a las escritoras.
+     *
+	 *  @param lock, lock de lectura/escritura
+	 *  @param timeout, ticks de espera máxima, OS_WAIT_FOREVER u OS_NO_WAIT
+	 *  @return true si se tomó el lock, false si venció el timeout.
+***************************************************************************************************/
+bool osReadLock(rwLock *lock, uint32_t timeout)
+{
+	bool taken = true;
+
+	/*
+	 * El lock se entrega a la tarea antes de despertarla, por lo que al volver de la espera
+	 * no es necesario verificar nuevamente su estado
+	 */
+	osEnterCritical();
+	if(!lock->writer && lock->writeWaitList == NULL)
+		lock->readers++;
+	else
+	{
+		OS_TRACE(TRACE_SEM_BLOCK, lock);
+		taken = osWaitEvent(&lock->readWaitList, timeout);
+	}
+	osExitCritical();
+
+	if(taken)
+		OS_TRACE(TRACE_SEM_TAKE, lock);
+	else
+		OS_TRACE(TRACE_TIMEOUT, lock);
+
+	return taken;
+}
+
+/*************************************************************************************************
+	 *  @brief función que libera un lock de lectura/escritura tomado para lectura
+     *
+     *  @details
+     *   La última lectora entrega el lock a la escritora de mayor prioridad que espera.
+     *
+	 *  @param lock, lock de lectura/escritura
+	 *  @return none.
+***************************************************************************************************/
+void osReadUnlock(rwLock *lock)
+{
+	osEnterCritical();
+	if(lock->readers > 0 && --lock->readers == 0 &&
+			grantWriter(lock) && osGetSytemState() == RUN_IRQ)
+		osSetScheduleFromISR(true);
+	osExitCritical();
+
+	OS_TRACE(TRACE_SEM_GIVE, lock);
+}
+
+/*************************************************************************************************
+	 *  @brief función que toma un lock de lectura/escritura para escritura
+     *
+     *  @details
+     *   Si alguna tarea tiene el lock la tarea se bloquea hasta que se le entregue el lock o
+     *   venza el timeout. Mientras espera, las nuevas lectoras también esperan.
+     *
+	 *  @param lock, lock de lectura/escritura
+	 *  @param timeout, ticks de espera máxima, OS_WAIT_FOREVER u OS_NO_WAIT
+	 *  @return true si se tomó el lock, false si venció el timeout.
+***************************************************************************************************/
+bool osWriteLock(rwLock *lock, uint32_t timeout)
+{
+	bool taken = true;
+
+	osEnterCritical();
+	if(!lock->writer && lock->readers == 0)
+		lock->writer = true;
+	else
+	{
+		OS_TRACE(TRACE_SEM_BLOCK, lock);
+		taken = osWaitEvent(&lock->writeWaitList, timeout);
+
+		/*
+		 * Si era la última escritora en espera, las lectoras que esperaban solo por ella
+		 * pueden tomar el lock
+		 */
+		if(!taken && !lock->writer && lock->writeWaitList == NULL)
+			grantReaders(lock);
+	}
+	osExitCritical();
+
+	if(taken)
+		OS_TRACE(TRACE_SEM_TAKE, lock);
+	else
+		OS_TRACE(TRACE_TIMEOUT, lock);
+
+	return taken;
+}
+
+/*************************************************************************************************
+	 *  @brief función que libera un lock de lectura/escritura tomado para escritura
+     *
+     *  @details
+     *   Entrega el lock a la escritora de mayor prioridad que espera o, si no hay, a todas las
+     *   lectoras que esperan.
+     *
+	 *  @param lock, lock de lectura/escritura
+	 *  @return none.
+***************************************************************************************************/
+void osWriteUnlock(rwLock *lock)
+{
+	bool woken;
+
+	osEnterCritical();
+	lock->writer = false;
+	woken = grantWriter(lock) || grantReaders(lock);
+	if(woken && osGetSytemState() == RUN_IRQ)
+		osSetScheduleFromISR(true);
+	osExitCritical();
+
+	OS_TRACE(TRACE_SEM_GIVE, lock);
 }
 
 /*************************************************************************************************
 	 *  @brief función de inicialicación de una cola
      *
      *  @details
-     *   Esta función inicializa el cola con la tarea asociada igual a null y el tamaño del
-     *   elemento que se va a transmitir
+     *   Esta función inicializa el cola sin tareas en espera y el tamaño del elemento que se
+     *   va a transmitir
      *
      *   Inicializa los indices a cero y determina el tamaño del dato que va a enviar
      *
@@ -156,7 +374,9 @@ void osInitQueue(queue *que, uint16_t size)
 	que->size = size;
 	que->head = 0;
 	que->tail = 0;
-	que->queueTask = NULL;
+	que->getWaitList = NULL;
+	que->putWaitList = NULL;
+	que->setWaitList = NULL;
 }
 
 /*************************************************************************************************
@@ -164,155 +384,487 @@ void osInitQueue(queue *que, uint16_t size)
      *
      *  @details
      *   Esta función realiza una copia en el vector de la cola los datos del puntero data
-     *   que entra como parametro
+     *   que entra como parametro. Si la cola está llena la tarea se bloquea hasta que otra
+     *   tarea lea un elemento o venza el timeout. Al escribir se despierta la tarea de mayor
+     *   prioridad que espera datos.
      *
+     *   Desde una interrupción la función no bloquea: si la cola está llena retorna false.
      *
 	 *  @param cola donde se va a escribir
 	 *  @param data, puntero de los datos a enviar
-	 *  @return none.
+	 *  @param timeout, ticks de espera máxima, OS_WAIT_FOREVER u OS_NO_WAIT
+	 *  @return true si el dato se escribió, false si venció el timeout.
 ***************************************************************************************************/
-void osPutQueue(queue *que, void* data)
+bool osPutQueue(queue *que, void* data, uint32_t timeout)
 {
-	task* currentTask;
+	uint32_t deadline = osGetTickCount() + timeout;
 	uint16_t elements;
-	uint16_t indexHead;
+
+	elements = QUEUE_SIZE / que->size;
+
+	osEnterCritical();
 	/*
-	 * Verifica que la cola no este vacia
+	 * Se verifica que la cola tenga espacio para incluir los datos, si no tiene la tarea
+	 * espera en la lista de la cola. La condición se vuelve a verificar al despertar porque
+	 * otra tarea pudo ocupar el lugar liberado
 	 * */
-	if(que->head == que->tail)
+	while((que->head + 1) % elements == que->tail)
 	{
-		/*
-		 * Verifica que la cola tenga una tarea asociada
-		 * */
-		if(que->queueTask != NULL)
+		OS_TRACE(TRACE_QUEUE_BLOCK, que);
+		if(!osWaitEvent(&que->putWaitList, waitRemaining(timeout, deadline)))
 		{
-			/*
-			 * Verifica que la tarea esté bloaqueda, en el caso de que
-			 * se bloqueo por algùn motivo se cambia a estado ready, porque
-			 * se escribira un dato en esa tarea
-			 * */
-			if(que->queueTask->state == BLOCKED)
-				que->queueTask->state = READY;
+			osExitCritical();
+			OS_TRACE(TRACE_TIMEOUT, que);
+			return false;
 		}
 	}
-	osEnterCritical();
 	/*
-	 * Obtengo el puntero de la tarea actual
+	 * Se realiza una copia de los datos en el vector de la pila en la posición del índice head
 	 * */
-	currentTask = getCurrentTask();
+	memcpy(que->data + que->head * que->size, data, que->size);
+	que->head = (que->head + 1) % elements;
+
+	if((osSignalEvent(&que->getWaitList) || osSignalSet(que->setWaitList)) &&
+			osGetSytemState() == RUN_IRQ)
+		osSetScheduleFromISR(true);
 	osExitCritical();
-	/*
-	 * Verifico que la tarea actual se esta ejecutando para realizar la copia
-	 * de los datos ingresados en la cola
-	 * */
-	if(currentTask->state == RUNNING)
-	{
-		elements = QUEUE_SIZE/que->size;
-		indexHead = que->head * que->size;
-		/*
-		 * Se verifica que la cola tenga espacio para incluir los datos
-		 * si no tiene el while bloquea la tarea actual y se forza a un
-		 * scheuler y cambio de contexto hasta que cumpla con la
-		 * condicion de tener lugar disponible
-		 * */
-		while((que->head + 1) % elements == que->tail)
-		{
-			osEnterCritical();
-			currentTask->state = BLOCKED;
-			que->queueTask = currentTask;
-			osExitCritical();
-			osForceSchCC();
-		}
-		/*
-		 * Se realiza una copia de los datos en el vector de la pila en la posición del índice head
-		 * */
-		memcpy(que->data + indexHead,data,que->size);
-		/*
-		 * Se desasocia la tarea de la cola
-		 * */
-		que->head = (que->head + 1) % elements;
-		que->queueTask = NULL;
-	}
+
+	OS_TRACE(TRACE_QUEUE_PUT, que);
+	return true;
 }
 
 /*************************************************************************************************
 	 *  @brief función obtiene los datos de la cola
      *
      *  @details
-     *   Esta función realiza una copia en el  puntero data
-     *   que entra como parametro del vector de la cola
+     *   Esta función realiza una copia en el  puntero data que entra como parametro del
+     *   vector de la cola. Si la cola está vacía la tarea se bloquea hasta que llegue un dato
+     *   o venza el timeout. Al leer se despierta la tarea de mayor prioridad que espera lugar.
      *
+     *   Desde una interrupción la función no bloquea: si la cola está vacía retorna false.
      *
 	 *  @param cola de donde se va a leer
 	 *  @param data, puntero de los datos a escribir
-	 *  @return none.
+	 *  @param timeout, ticks de espera máxima, OS_WAIT_FOREVER u OS_NO_WAIT
+	 *  @return true si se leyó un dato, false si venció el timeout.
 ***************************************************************************************************/
-void osGetQueue(queue *que, void* data)
+bool osGetQueue(queue *que, void* data, uint32_t timeout)
 {
-	task* currentTask;
+	uint32_t deadline = osGetTickCount() + timeout;
 	uint16_t elements;
-	uint16_t indexTail;
 
 	elements = QUEUE_SIZE / que->size;
+
+	osEnterCritical();
 	/*
-	 * Se verifica que la cola esté llena
+	 * Se verifica que la cola tenga datos por leer, si no tiene la tarea espera en la lista
+	 * de la cola hasta que se escriba un dato
 	 * */
-	if((que->head + 1) % elements == que->tail)
+	while(que->head == que->tail)
 	{
-		/*
-		 * Verifica que la cola tenga una tarea asociada
-		 * */
-		if(que->queueTask != NULL)
+		OS_TRACE(TRACE_QUEUE_BLOCK, que);
+		if(!osWaitEvent(&que->getWaitList, waitRemaining(timeout, deadline)))
 		{
-			/*
-			 * Verifica que la tarea esté bloaqueda, en el caso de que
-			 * se bloqueo por algùn motivo se cambia a estado ready, porque
-			 * se leerá un dato en esa tarea
-			 * */
-			if(que->queueTask->state == BLOCKED)
-				que->queueTask->state = READY;
+			osExitCritical();
+			OS_TRACE(TRACE_TIMEOUT, que);
+			return false;
 		}
 	}
-	osEnterCritical();
 	/*
-	 * Obtengo el puntero de la tarea actual
+	 * Se realiza una copia vector de la pila al elemento que entra
+	 * como parametro de los datos en el en la posición del índice Tail
 	 * */
-	currentTask = getCurrentTask();
+	memcpy(data, que->data + que->tail * que->size, que->size);
+	que->tail = (que->tail + 1) % elements;
+
+	if(osSignalEvent(&que->putWaitList) && osGetSytemState() == RUN_IRQ)
+		osSetScheduleFromISR(true);
 	osExitCritical();
-	/*
-	 * Verifico que la tarea actual se esta ejecutando para realizar la copia
-	 * de los datos ingresados en la cola
-	 * */
-	if(currentTask->state == RUNNING)
+
+	OS_TRACE(TRACE_QUEUE_GET, que);
+	return true;
+}
+
+/*************************************************************************************************
+	 *  @brief Copia bytes al buffer circular
+     *
+     *  @details
+     *   Copia length bytes a partir del índice head en como máximo dos bloques, el segundo
+     *   cuando la escritura da la vuelta al final del almacenamiento. Debe llamarse dentro de
+     *   una sección crítica y con lugar suficiente en el buffer.
+     *
+	 *  @param sb, buffer donde se escribe
+	 *  @param data, bytes a copiar
+	 *  @param length, cantidad de bytes
+	 *  @return none.
+***************************************************************************************************/
+static void streamCopyIn(streamBuffer *sb, const uint8_t *data, uint16_t length)
+{
+	uint16_t first = sb->size - sb->head;
+
+	if(first > length)
+		first = length;
+
+	memcpy(sb->buffer + sb->head, data, first);
+	memcpy(sb->buffer, data + first, length - first);
+
+	sb->head = (uint16_t)((sb->head + length) % sb->size);
+	sb->count += length;
+}
+
+/*************************************************************************************************
+	 *  @brief Copia bytes desde el buffer circular sin consumirlos
+     *
+     *  @details
+     *   Copia length bytes a partir del índice tail en como máximo dos bloques. Los índices no
+     *   se modifican, los bytes se consumen con streamConsume. Debe llamarse dentro de una
+     *   sección crítica y con length bytes almacenados.
+     *
+	 *  @param sb, buffer de donde se lee
+	 *  @param data, destino de la copia
+	 *  @param length, cantidad de bytes
+	 *  @return none.
+***************************************************************************************************/
+static void streamPeek(const streamBuffer *sb, uint8_t *data, uint16_t length)
+{
+	uint16_t first = sb->size - sb->tail;
+
+	if(first > length)
+		first = length;
+
+	memcpy(data, sb->buffer + sb->tail, first);
+	memcpy(data + first, sb->buffer, length - first);
+}
+
+/*************************************************************************************************
+	 *  @brief Descarta bytes leídos del buffer circular
+     *
+	 *  @param sb, buffer de donde se leyó
+	 *  @param length, cantidad de bytes, como máximo los almacenados
+	 *  @return none.
+***************************************************************************************************/
+static void streamConsume(streamBuffer *sb, uint16_t length)
+{
+	sb->tail = (uint16_t)((sb->tail + length) % sb->size);
+	sb->count -= length;
+}
+
+/*************************************************************************************************
+	 *  @brief función de inicialización de un buffer de bytes
+     *
+     *  @details
+     *   Inicializa el buffer vacío sobre el almacenamiento provisto por la aplicación. El
+     *   nivel de disparo se limita al rango 1..size.
+     *
+	 *  @param sb, buffer que se va a inicializar
+	 *  @param buffer, almacenamiento de size bytes
+	 *  @param size, tamaño del almacenamiento en bytes
+	 *  @param triggerLevel, bytes que deben estar disponibles para despertar a la tarea lectora
+	 *  @return none.
+***************************************************************************************************/
+void osInitStreamBuffer(streamBuffer *sb, uint8_t *buffer, uint16_t size, uint16_t triggerLevel)
+{
+	if(triggerLevel == 0)
+		triggerLevel = 1;
+	if(triggerLevel > size)
+		triggerLevel = size;
+
+	sb->buffer = buffer;
+	sb->size = size;
+	sb->head = 0;
+	sb->tail = 0;
+	sb->count = 0;
+	sb->triggerLevel = triggerLevel;
+	sb->readWaitList = NULL;
+	sb->writeWaitList = NULL;
+	sb->setWaitList = NULL;
+}
+
+/*************************************************************************************************
+	 *  @brief función que escribe bytes en un buffer de bytes
+     *
+     *  @details
+     *   Copia los bytes en bloques tan grandes como el lugar libre lo permita. Si el buffer se
+     *   llena la tarea se bloquea hasta que se lean datos o venza el timeout. La tarea lectora
+     *   se despierta solo cuando hay al menos triggerLevel bytes almacenados, por lo que un
+     *   productor de a pocos bytes no provoca un cambio de contexto por cada escritura.
+     *
+     *   Desde una interrupción la función no bloquea y escribe solo lo que entra en el buffer.
+     *   Está pensado para una única tarea escritora y una única tarea lectora.
+     *
+	 *  @param sb, buffer donde se escribe
+	 *  @param data, bytes a escribir
+	 *  @param length, cantidad de bytes
+	 *  @param timeout, ticks de espera máxima, OS_WAIT_FOREVER u OS_NO_WAIT
+	 *  @return bytes escritos, menos de length si venció el timeout.
+***************************************************************************************************/
+uint16_t osWriteStream(streamBuffer *sb, const void *data, uint16_t length, uint32_t timeout)
+{
+	uint32_t deadline = osGetTickCount() + timeout;
+	const uint8_t *src = data;
+	uint16_t written = 0;
+	uint16_t chunk;
+
+	osEnterCritical();
+	while(written < length)
 	{
-		indexTail = que->tail * que->size;
+		chunk = sb->size - sb->count;
+		if(chunk == 0)
+		{
+			OS_TRACE(TRACE_QUEUE_BLOCK, sb);
+			if(!osWaitEvent(&sb->writeWaitList, waitRemaining(timeout, deadline)))
+				break;
+			continue;
+		}
+		if(chunk > length - written)
+			chunk = length - written;
+
+		streamCopyIn(sb, src + written, chunk);
+		written += chunk;
+
 		/*
-		 * Se verifica que la cola tenga datos por lees
-		 * si no tiene datos por leer el while bloquea la tarea actual y
-		 * se forza a un scheuler y cambio de contexto hasta que cumpla
-		 * con la condicion de tener datos por leer
-		 * */
-		while(que->head == que->tail)
+		 * Se despierta a la lectora antes de bloquear por buffer lleno, ya que con el buffer
+		 * lleno siempre se alcanza el nivel de disparo
+		 */
+		if(sb->count >= sb->triggerLevel &&
+				(osSignalEvent(&sb->readWaitList) || osSignalSet(sb->setWaitList)) &&
+				osGetSytemState() == RUN_IRQ)
+			osSetScheduleFromISR(true);
+	}
+	osExitCritical();
+
+	if(written < length)
+		OS_TRACE(TRACE_TIMEOUT, sb);
+	else
+		OS_TRACE(TRACE_QUEUE_PUT, sb);
+
+	return written;
+}
+
+/*************************************************************************************************
+	 *  @brief función que lee bytes de un buffer de bytes
+     *
+     *  @details
+     *   Si hay menos de triggerLevel bytes almacenados la tarea se bloquea hasta alcanzar el
+     *   nivel de disparo o hasta que venza el timeout. Luego copia hasta length bytes en un
+     *   solo llamado y despierta a la tarea que espera lugar. Al vencer el timeout se leen
+     *   los bytes disponibles aunque no lleguen al nivel de disparo.
+     *
+     *   Desde una interrupción la función no bloquea.
+     *
+	 *  @param sb, buffer de donde se lee
+	 *  @param data, destino de los bytes
+	 *  @param length, cantidad máxima de bytes a leer
+	 *  @param timeout, ticks de espera máxima, OS_WAIT_FOREVER u OS_NO_WAIT
+	 *  @return bytes leídos, 0 si venció el timeout con el buffer vacío.
+***************************************************************************************************/
+uint16_t osReadStream(streamBuffer *sb, void *data, uint16_t length, uint32_t timeout)
+{
+	uint32_t deadline = osGetTickCount() + timeout;
+	uint16_t read;
+
+	osEnterCritical();
+	while(sb->count < sb->triggerLevel)
+	{
+		OS_TRACE(TRACE_QUEUE_BLOCK, sb);
+		if(!osWaitEvent(&sb->readWaitList, waitRemaining(timeout, deadline)))
+			break;
+	}
+
+	read = sb->count < length ? sb->count : length;
+	if(read > 0)
+	{
+		streamPeek(sb, data, read);
+		streamConsume(sb, read);
+
+		if(osSignalEvent(&sb->writeWaitList) && osGetSytemState() == RUN_IRQ)
+			osSetScheduleFromISR(true);
+	}
+	osExitCritical();
+
+	if(read > 0)
+		OS_TRACE(TRACE_QUEUE_GET, sb);
+	else
+		OS_TRACE(TRACE_TIMEOUT, sb);
+
+	return read;
+}
+
+/*************************************************************************************************
+	 *  @brief función de inicialización de un buffer de mensajes
+     *
+     *  @details
+     *   Inicializa el buffer vacío sobre el almacenamiento provisto por la aplicación. Cada
+     *   mensaje ocupa MESSAGE_HEADER_SIZE bytes más su largo.
+     *
+	 *  @param mb, buffer que se va a inicializar
+	 *  @param buffer, almacenamiento de size bytes
+	 *  @param size, tamaño del almacenamiento en bytes
+	 *  @return none.
+***************************************************************************************************/
+void osInitMessageBuffer(messageBuffer *mb, uint8_t *buffer, uint16_t size)
+{
+	osInitStreamBuffer(mb, buffer, size, 1);
+}
+
+/*************************************************************************************************
+	 *  @brief función que envía un mensaje por un buffer de mensajes
+     *
+     *  @details
+     *   El mensaje se escribe completo precedido por su largo, o no se escribe. Si no hay
+     *   lugar para el mensaje la tarea se bloquea hasta que se lean mensajes o venza el
+     *   timeout. La tarea lectora se despierta una vez por mensaje y no por cada byte.
+     *
+     *   Desde una interrupción la función no bloquea.
+     *
+	 *  @param mb, buffer donde se escribe
+	 *  @param message, datos del mensaje
+	 *  @param length, largo del mensaje, mayor que cero
+	 *  @param timeout, ticks de espera máxima, OS_WAIT_FOREVER u OS_NO_WAIT
+	 *  @return true si se envió el mensaje, false si venció el timeout o el mensaje no entra
+	 *  en el buffer.
+***************************************************************************************************/
+bool osSendMessage(messageBuffer *mb, const void *message, uint16_t length, uint32_t timeout)
+{
+	uint32_t deadline = osGetTickCount() + timeout;
+	uint16_t header = length;
+
+	if(length == 0 || length > mb->size - MESSAGE_HEADER_SIZE)
+		return false;
+
+	osEnterCritical();
+	while(mb->size - mb->count < length + MESSAGE_HEADER_SIZE)
+	{
+		OS_TRACE(TRACE_QUEUE_BLOCK, mb);
+		if(!osWaitEvent(&mb->writeWaitList, waitRemaining(timeout, deadline)))
 		{
-			osEnterCritical();
-			currentTask->state = BLOCKED;
 			osExitCritical();
-			que->queueTask = currentTask;
-			osForceSchCC();
+			OS_TRACE(TRACE_TIMEOUT, mb);
+			return false;
+		}
+	}
+
+	streamCopyIn(mb, (const uint8_t *)&header, MESSAGE_HEADER_SIZE);
+	streamCopyIn(mb, message, length);
+
+	if((osSignalEvent(&mb->readWaitList) || osSignalSet(mb->setWaitList)) &&
+			osGetSytemState() == RUN_IRQ)
+		osSetScheduleFromISR(true);
+	osExitCritical();
+
+	OS_TRACE(TRACE_QUEUE_PUT, mb);
+	return true;
+}
+
+/*************************************************************************************************
+	 *  @brief función que recibe un mensaje de un buffer de mensajes
+     *
+     *  @details
+     *   Si el buffer está vacío la tarea se bloquea hasta que llegue un mensaje o venza el
+     *   timeout. El mensaje se copia completo; si es más largo que maxLength se descarta sin
+     *   copiarlo, ya que si quedara en el buffer bloquearía a todos los mensajes siguientes.
+     *
+     *   Desde una interrupción la función no bloquea.
+     *
+	 *  @param mb, buffer de donde se lee
+	 *  @param message, destino del mensaje
+	 *  @param maxLength, tamaño del destino en bytes
+	 *  @param timeout, ticks de espera máxima, OS_WAIT_FOREVER u OS_NO_WAIT
+	 *  @return largo del mensaje recibido, 0 si venció el timeout o MESSAGE_DISCARDED si el
+	 *  mensaje era más largo que maxLength y se descartó.
+***************************************************************************************************/
+uint16_t osReceiveMessage(messageBuffer *mb, void *message, uint16_t maxLength, uint32_t timeout)
+{
+	uint32_t deadline = osGetTickCount() + timeout;
+	uint16_t length;
+
+	osEnterCritical();
+	while(mb->count == 0)
+	{
+		OS_TRACE(TRACE_QUEUE_BLOCK, mb);
+		if(!osWaitEvent(&mb->readWaitList, waitRemaining(timeout, deadline)))
+		{
+			osExitCritical();
+			OS_TRACE(TRACE_TIMEOUT, mb);
+			return 0;
 		}
-		/*
-		 * Se realiza una copia vector de la pila al elemento que entra
-		 * como parametro de los datos en el en la posición del índice Tail
-		 * */
-		memcpy(data,que->data + indexTail,que->size);
-		/*
-		 * Se actualiza el índice Head
-		 * */
-		que->tail = (que->tail + 1) % elements;
-		/*
-		 * Se desasocia la tarea de la cola
-		 * */
-		que->queueTask = NULL;
 	}
+
+	streamPeek(mb, (uint8_t *)&length, MESSAGE_HEADER_SIZE);
+	streamConsume(mb, MESSAGE_HEADER_SIZE);
+	if(length <= maxLength)
+		streamPeek(mb, message, length);
+	streamConsume(mb, length);
+
+	if(osSignalEvent(&mb->writeWaitList) && osGetSytemState() == RUN_IRQ)
+		osSetScheduleFromISR(true);
+	osExitCritical();
+
+	OS_TRACE(TRACE_QUEUE_GET, mb);
+	return length <= maxLength ? length : MESSAGE_DISCARDED;
+}
+
+/*************************************************************************************************
+	 *  @brief función de inicialización de un valor de última muestra
+     *
+	 *  @param sv, valor que se va a inicializar sin muestras
+	 *  @param buffers, almacenamiento de 2 * size bytes
+	 *  @param size, tamaño de la muestra
+	 *  @return none.
+***************************************************************************************************/
+void osInitSeqValue(seqValue *sv, uint8_t *buffers, uint16_t size)
+{
+	sv->buffers = buffers;
+	sv->size = size;
+	sv->sequence = 0;
 }
 
+/*************************************************************************************************
+	 *  @brief función que publica una muestra
+     *
+     *  @details
+     *   Copia la muestra en el buffer no publicado y luego lo publica incrementando sequence,
+     *   sin sección crítica. Debe haber un único escritor, que puede ser una interrupción.
+     *   Como el escritor nunca modifica el buffer publicado, una lectora de mayor prioridad que
+     *   lo interrumpe a mitad de la copia lee la muestra anterior completa.
+     *
+	 *  @param sv, valor de última muestra
+	 *  @param data, muestra de sv->size bytes
+	 *  @return none.
+***************************************************************************************************/
+void osWriteSeqValue(seqValue *sv, const void *data)
+{
+	uint32_t next = sv->sequence + 1;
+
+	memcpy(sv->buffers + (next & 1) * sv->size, data, sv->size);
+	portMemoryBarrier();
+	sv->sequence = next;
+}
+
+/*************************************************************************************************
+	 *  @brief función que lee la última muestra
+     *
+     *  @details
+     *   No bloquea ni deshabilita interrupciones. Si el escritor publicó durante la copia el
+     *   buffer leído pudo estar siendo sobrescrito y la copia se repite, por lo que la lectura
+     *   solo puede demorarse si el escritor publica más rápido de lo que tarda una copia.
+     *
+	 *  @param sv, valor de última muestra
+	 *  @param data, destino de la muestra
+	 *  @return número de la muestra leída, 0 si todavía no se publicó ninguna. Comparándolo
+	 *  con el de la lectura anterior la tarea sabe si hay una muestra nueva.
+***************************************************************************************************/
+uint32_t osReadSeqValue(const seqValue *sv, void *data)
+{
+	uint32_t sequence;
+
+	do
+	{
+		sequence = sv->sequence;
+		portMemoryBarrier();
+		memcpy(data, sv->buffers + (sequence & 1) * sv->size, sv->size);
+		portMemoryBarrier();
+	} while(sequence != sv->sequence);
+
+	return sequence;
+}
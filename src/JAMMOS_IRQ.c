@@ -6,9 +6,30 @@
  */
 
 #include "JAMMOS_IRQ.h"
+#include "JAMMOS_TRACE.h"
+#include <string.h>
 
 static void* isrUserVector[IRQ_QUANTITY];
 
+#if JAMMOS_IRQ_STATS
+/*
+ * Acumuladores de las estadísticas de cada interrupción. Los totales son de 64 bits para
+ * que el promedio no se pierda por desborde en ejecuciones largas
+ */
+struct _irqCounters {
+	uint32_t count;
+	uint32_t minCycles;
+	uint32_t maxCycles;
+	uint64_t totalCycles;
+	uint32_t minLatency;
+	uint32_t maxLatency;
+	uint64_t totalLatency;
+	uint32_t scheduleCount;
+};
+
+static struct _irqCounters irqCounters[IRQ_QUANTITY];
+#endif
+
 /*************************************************************************************************
 	 *  @brief Función que configura una interupnción para el sistema operativo
      *
@@ -19,15 +40,15 @@ static void* isrUserVector[IRQ_QUANTITY];
 	 *  @param 		usrIsr puntero a la función que el usuario quiere que se llame cuando ocurra la interrupción
 	 *  @return     bool obtiene el valor de si la instalación de la interrupción fué satisfactoria
 ***************************************************************************************************/
-bool osInstallIRQ(LPC43XX_IRQn_Type irq, void* usrIsr)
+bool osInstallIRQ(portIrqType irq, void* usrIsr)
 {
 	bool irqInstallOk = 0;
 
-	if (isrUserVector[irq] == NULL)
+	if (irq >= 0 && irq < IRQ_QUANTITY && isrUserVector[irq] == NULL)
 	{
 		isrUserVector[irq] = usrIsr;
-		NVIC_ClearPendingIRQ(irq);
-		NVIC_EnableIRQ(irq);
+		portClearIrqLine(irq);
+		portEnableIrqLine(irq);
 		irqInstallOk = true;
 	}
 
@@ -43,15 +64,15 @@ bool osInstallIRQ(LPC43XX_IRQn_Type irq, void* usrIsr)
 	 *  @param 		IRQ parámetro que contiene el valor de la interupción correspondiente a la que se desea activar
 	 *  @return     bool obtiene el valor de si la desinstalación de la interrupción fué satisfactoria
 ***************************************************************************************************/
-bool osRemoveIRQ(LPC43XX_IRQn_Type irq)
+bool osRemoveIRQ(portIrqType irq)
 {
 	bool irqRemoveOk = 0;
 
-	if (isrUserVector[irq] != NULL)
+	if (irq >= 0 && irq < IRQ_QUANTITY && isrUserVector[irq] != NULL)
 	{
 		isrUserVector[irq] = NULL;
-		NVIC_ClearPendingIRQ(irq);
-		NVIC_DisableIRQ(irq);
+		portClearIrqLine(irq);
+		portDisableIrqLine(irq);
 		irqRemoveOk = true;
 	}
 
@@ -68,82 +89,126 @@ bool osRemoveIRQ(LPC43XX_IRQn_Type irq)
 	 *  @brief Función se llama cuando alguna interrupción es llamada
      *
      *  @details
-     *  Función que determina la función de uruario a llamar dependiendo del valor del parámetro IRQn
+     *  Función que determina la función de uruario a llamar dependiendo del valor del parámetro IRQn.
+     *  La llaman los handlers de la tabla de vectores de cada port.
      *
 	 *  @param 		IRQn parámetro que contiene el valor de la interupción correspondiente a la que se
 					ha llamado
 	 *  @return     none
 ***************************************************************************************************/
-static void osIrqHandler(LPC43XX_IRQn_Type IRQn)  {
+OS_RAMFUNC void osIrqHandler(portIrqType IRQn)  {
 	osState osPreviousState;
 	void (*userFuntion)(void);
+#if JAMMOS_IRQ_STATS
+	uint32_t entryCycles;
+	uint32_t latency;
+	uint32_t duration;
+	bool schedule;
+	struct _irqCounters *counters;
+
+	/*
+	 * Se toma la marca de tiempo de entrada lo antes posible dentro del handler
+	 */
+	entryCycles = portGetCycles();
+#endif
+
+	OS_TRACE(TRACE_IRQ_ENTER, IRQn);
 
 	osPreviousState = osGetSytemState();
 
 	osSetSytemState(RUN_IRQ);
 
 	userFuntion = isrUserVector[IRQn];
+#if JAMMOS_IRQ_STATS
+	latency = portGetCycles() - entryCycles;
+#endif
 	userFuntion();
 
 	osSetSytemState(osPreviousState);
 
-	NVIC_ClearPendingIRQ(IRQn);
+	portClearIrqLine(IRQn);
+
+	OS_TRACE(TRACE_IRQ_EXIT, IRQn);
+
+#if JAMMOS_IRQ_STATS
+	schedule = osGetScheduleFromISR();
+#endif
 
 	if (osGetScheduleFromISR())  {
 		osSetScheduleFromISR(false);
 		osForceSchCC();
 	}
+
+#if JAMMOS_IRQ_STATS
+	/*
+	 * Se actualizan las estadísticas de la interrupción. La duración incluye el scheduling
+	 * pedido por la ISR de usuario, que es parte del costo real de la interrupción
+	 */
+	duration = portGetCycles() - entryCycles;
+	counters = &irqCounters[IRQn];
+
+	if(counters->count == 0 || duration < counters->minCycles)
+		counters->minCycles = duration;
+	if(duration > counters->maxCycles)
+		counters->maxCycles = duration;
+	if(counters->count == 0 || latency < counters->minLatency)
+		counters->minLatency = latency;
+	if(latency > counters->maxLatency)
+		counters->maxLatency = latency;
+
+	counters->totalCycles += duration;
+	counters->totalLatency += latency;
+	counters->count++;
+	if(schedule)
+		counters->scheduleCount++;
+#endif
+}
+
+#if JAMMOS_IRQ_STATS
+/*************************************************************************************************
+	 *  @brief Función que obtiene las estadísticas de una interrupción
+     *
+     *  @details
+     *  Copia dentro de una sección crítica los contadores de la interrupción y calcula los
+     *  promedios de duración y latencia. Los tiempos se expresan en ciclos de CPU.
+     *
+	 *  @param 		irq parámetro con el número de la interupción
+	 *  @param 		stats estructura donde se copian las estadísticas
+	 *  @return     bool false si el número de interrupción no es válido
+***************************************************************************************************/
+bool osGetIrqStats(portIrqType irq, irqStats *stats)
+{
+	struct _irqCounters *counters;
+
+	if(irq < 0 || irq >= IRQ_QUANTITY)
+		return false;
+
+	counters = &irqCounters[irq];
+
+	osEnterCritical();
+	stats->count = counters->count;
+	stats->minCycles = counters->minCycles;
+	stats->maxCycles = counters->maxCycles;
+	stats->avgCycles = counters->count ? (uint32_t)(counters->totalCycles / counters->count) : 0;
+	stats->minLatency = counters->minLatency;
+	stats->maxLatency = counters->maxLatency;
+	stats->avgLatency = counters->count ? (uint32_t)(counters->totalLatency / counters->count) : 0;
+	stats->scheduleCount = counters->scheduleCount;
+	osExitCritical();
+
+	return true;
 }
 
-/*==================[interrupt service routines]=============================*/
-
-void DAC_IRQHandler(void){osIrqHandler(         DAC_IRQn         );}
-void M0APP_IRQHandler(void){osIrqHandler(       M0APP_IRQn       );}
-void DMA_IRQHandler(void){osIrqHandler(         DMA_IRQn         );}
-void FLASH_EEPROM_IRQHandler(void){osIrqHandler(RESERVED1_IRQn   );}
-void ETH_IRQHandler(void){osIrqHandler(         ETHERNET_IRQn    );}
-void SDIO_IRQHandler(void){osIrqHandler(        SDIO_IRQn        );}
-void LCD_IRQHandler(void){osIrqHandler(         LCD_IRQn         );}
-void USB0_IRQHandler(void){osIrqHandler(        USB0_IRQn        );}
-void USB1_IRQHandler(void){osIrqHandler(        USB1_IRQn        );}
-void SCT_IRQHandler(void){osIrqHandler(         SCT_IRQn         );}
-void RIT_IRQHandler(void){osIrqHandler(         RITIMER_IRQn     );}
-void TIMER0_IRQHandler(void){osIrqHandler(      TIMER0_IRQn      );}
-void TIMER1_IRQHandler(void){osIrqHandler(      TIMER1_IRQn      );}
-void TIMER2_IRQHandler(void){osIrqHandler(      TIMER2_IRQn      );}
-void TIMER3_IRQHandler(void){osIrqHandler(      TIMER3_IRQn      );}
-void MCPWM_IRQHandler(void){osIrqHandler(       MCPWM_IRQn       );}
-void ADC0_IRQHandler(void){osIrqHandler(        ADC0_IRQn        );}
-void I2C0_IRQHandler(void){osIrqHandler(        I2C0_IRQn        );}
-void SPI_IRQHandler(void){osIrqHandler(         I2C1_IRQn        );}
-void I2C1_IRQHandler(void){osIrqHandler(        SPI_INT_IRQn     );}
-void ADC1_IRQHandler(void){osIrqHandler(        ADC1_IRQn        );}
-void SSP0_IRQHandler(void){osIrqHandler(        SSP0_IRQn        );}
-void SSP1_IRQHandler(void){osIrqHandler(        SSP1_IRQn        );}
-void UART0_IRQHandler(void){osIrqHandler(       USART0_IRQn      );}
-void UART1_IRQHandler(void){osIrqHandler(       UART1_IRQn       );}
-void UART2_IRQHandler(void){osIrqHandler(       USART2_IRQn      );}
-void UART3_IRQHandler(void){osIrqHandler(       USART3_IRQn      );}
-void I2S0_IRQHandler(void){osIrqHandler(        I2S0_IRQn        );}
-void I2S1_IRQHandler(void){osIrqHandler(        I2S1_IRQn        );}
-void SPIFI_IRQHandler(void){osIrqHandler(       RESERVED4_IRQn   );}
-void SGPIO_IRQHandler(void){osIrqHandler(       SGPIO_INT_IRQn   );}
-void GPIO0_IRQHandler(void){osIrqHandler(       PIN_INT0_IRQn    );}
-void GPIO1_IRQHandler(void){osIrqHandler(       PIN_INT1_IRQn    );}
-void GPIO2_IRQHandler(void){osIrqHandler(       PIN_INT2_IRQn    );}
-void GPIO3_IRQHandler(void){osIrqHandler(       PIN_INT3_IRQn    );}
-void GPIO4_IRQHandler(void){osIrqHandler(       PIN_INT4_IRQn    );}
-void GPIO5_IRQHandler(void){osIrqHandler(       PIN_INT5_IRQn    );}
-void GPIO6_IRQHandler(void){osIrqHandler(       PIN_INT6_IRQn    );}
-void GPIO7_IRQHandler(void){osIrqHandler(       PIN_INT7_IRQn    );}
-void GINT0_IRQHandler(void){osIrqHandler(       GINT0_IRQn       );}
-void GINT1_IRQHandler(void){osIrqHandler(       GINT1_IRQn       );}
-void EVRT_IRQHandler(void){osIrqHandler(        EVENTROUTER_IRQn );}
-void CAN1_IRQHandler(void){osIrqHandler(        C_CAN1_IRQn      );}
-void ADCHS_IRQHandler(void){osIrqHandler(       ADCHS_IRQn       );}
-void ATIMER_IRQHandler(void){osIrqHandler(      ATIMER_IRQn      );}
-void RTC_IRQHandler(void){osIrqHandler(         RTC_IRQn         );}
-void WDT_IRQHandler(void){osIrqHandler(         WWDT_IRQn        );}
-void M0SUB_IRQHandler(void){osIrqHandler(       M0SUB_IRQn       );}
-void CAN0_IRQHandler(void){osIrqHandler(        C_CAN0_IRQn      );}
-void QEI_IRQHandler(void){osIrqHandler(         QEI_IRQn         );}
+/*************************************************************************************************
+	 *  @brief Función que reinicia las estadísticas de todas las interrupciones
+     *
+	 *  @param 		none
+	 *  @return     none
+***************************************************************************************************/
+void osResetIrqStats(void)
+{
+	osEnterCritical();
+	memset(irqCounters, 0, sizeof(irqCounters));
+	osExitCritical();
+}
+#endif
@@ -0,0 +1,268 @@
+/*
+ * JAMMOS_MEM.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#include "JAMMOS_MEM.h"
+
+/*
+ * Buffers y pools de las clases de tamaño de osMemAlloc
+ */
+OS_POOL_BUFFER(memClass0Buffer, MEM_CLASS_0_SIZE, MEM_CLASS_0_COUNT);
+OS_POOL_BUFFER(memClass1Buffer, MEM_CLASS_1_SIZE, MEM_CLASS_1_COUNT);
+OS_POOL_BUFFER(memClass2Buffer, MEM_CLASS_2_SIZE, MEM_CLASS_2_COUNT);
+OS_POOL_BUFFER(memClass3Buffer, MEM_CLASS_3_SIZE, MEM_CLASS_3_COUNT);
+
+static memPool memClass[MEM_CLASS_QUANTITY];
+
+/*************************************************************************************************
+	 *  @brief función de inicialicación de un pool de bloques fijos
+     *
+     *  @details
+     *   Esta función divide el buffer en blockCount bloques de blockSize bytes y los encadena
+     *   en la lista de bloques libres. Cada bloque libre guarda en sus primeros bytes el
+     *   puntero al siguiente bloque libre, por lo que el pool no ocupa memoria adicional.
+     *
+	 *  @param pool, pool que se va a inicializar
+	 *  @param buffer, memoria del pool alineada a palabra (ver OS_POOL_BUFFER)
+	 *  @param blockSize, tamaño de cada bloque en bytes
+	 *  @param blockCount, cantidad de bloques del pool
+	 *  @return none.
+***************************************************************************************************/
+void osInitPool(memPool *pool, void *buffer, uint32_t blockSize, uint16_t blockCount)
+{
+	uint16_t i;
+	uint8_t *block;
+
+	pool->buffer = buffer;
+	pool->blockSize = POOL_BLOCK_SIZE(blockSize);
+	pool->blockCount = blockCount;
+	pool->freeCount = blockCount;
+	pool->minFree = blockCount;
+	pool->allocCount = 0;
+	pool->failCount = 0;
+	pool->fallbackCount = 0;
+	pool->freeList = NULL;
+
+	/*
+	 * Se encadenan los bloques desde el último al primero para que las primeras
+	 * asignaciones entreguen los bloques en orden de dirección
+	 * */
+	for(i = blockCount; i > 0; i--)
+	{
+		block = pool->buffer + (uint32_t)(i - 1) * pool->blockSize;
+		*(void**)block = pool->freeList;
+		pool->freeList = block;
+	}
+}
+
+/*************************************************************************************************
+	 *  @brief Extrae un bloque libre del pool sin contabilizar el fallo
+     *
+     *  @details
+     *   Debe llamarse dentro de una sección crítica.
+     *
+	 *  @param pool, pool del que se obtiene el bloque
+	 *  @return puntero al bloque o NULL si el pool no tiene bloques libres.
+***************************************************************************************************/
+static void* poolTake(memPool *pool)
+{
+	void *block = pool->freeList;
+
+	if(block != NULL)
+	{
+		pool->freeList = *(void**)block;
+		pool->freeCount--;
+		pool->allocCount++;
+		if(pool->freeCount < pool->minFree)
+			pool->minFree = pool->freeCount;
+	}
+
+	return block;
+}
+
+/*************************************************************************************************
+	 *  @brief función que obtiene un bloque del pool
+     *
+     *  @details
+     *   Extrae el primer bloque de la lista de bloques libres en tiempo constante. Puede ser
+     *   llamada desde tareas o interrupciones.
+     *
+	 *  @param pool, pool del que se obtiene el bloque
+	 *  @return puntero al bloque o NULL si el pool no tiene bloques libres.
+***************************************************************************************************/
+void* osPoolAlloc(memPool *pool)
+{
+	void *block;
+
+	osEnterCritical();
+	block = poolTake(pool);
+	if(block == NULL)
+		pool->failCount++;
+	osExitCritical();
+
+	return block;
+}
+
+/*************************************************************************************************
+	 *  @brief función que devuelve un bloque al pool
+     *
+     *  @details
+     *   Inserta el bloque al inicio de la lista de bloques libres en tiempo constante. Puede ser
+     *   llamada desde tareas o interrupciones.
+     *
+	 *  @param pool, pool al que pertenece el bloque
+	 *  @param block, bloque que se libera
+	 *  @return none.
+***************************************************************************************************/
+void osPoolFree(memPool *pool, void *block)
+{
+	if(block != NULL)
+	{
+		osEnterCritical();
+		*(void**)block = pool->freeList;
+		pool->freeList = block;
+		pool->freeCount++;
+		osExitCritical();
+	}
+}
+
+/*************************************************************************************************
+	 *  @brief función que verifica si un bloque pertenece al pool
+     *
+	 *  @param pool, pool que se verifica
+	 *  @param block, puntero al bloque
+	 *  @return bool true si el bloque está dentro de la memoria del pool.
+***************************************************************************************************/
+bool osPoolContains(memPool *pool, void *block)
+{
+	uint8_t *ptr = block;
+
+	return pool->buffer != NULL && ptr >= pool->buffer &&
+		   ptr < pool->buffer + (uint32_t)pool->blockCount * pool->blockSize;
+}
+
+/*************************************************************************************************
+	 *  @brief función que obtiene las estadísticas de uso de un pool
+     *
+     *  @details
+     *   Copia las estadísticas dentro de una sección crítica para que los valores sean
+     *   coherentes entre si.
+     *
+	 *  @param pool, pool del que se obtienen las estadísticas
+	 *  @param stats, estructura donde se copian las estadísticas
+	 *  @return none.
+***************************************************************************************************/
+void osGetPoolStats(memPool *pool, memPoolStats *stats)
+{
+	osEnterCritical();
+	stats->blockSize = pool->blockSize;
+	stats->blockCount = pool->blockCount;
+	stats->freeCount = pool->freeCount;
+	stats->minFree = pool->minFree;
+	stats->allocCount = pool->allocCount;
+	stats->failCount = pool->failCount;
+	stats->fallbackCount = pool->fallbackCount;
+	osExitCritical();
+}
+
+/*************************************************************************************************
+	 *  @brief función de inicialicación del asignador por clases de tamaño
+     *
+     *  @details
+     *   Inicializa un pool de bloques fijos por cada clase de tamaño. Es llamada por osInit.
+     *
+	 *  @param none
+	 *  @return none.
+***************************************************************************************************/
+void osInitMem(void)
+{
+	osInitPool(&memClass[0], memClass0Buffer, MEM_CLASS_0_SIZE, MEM_CLASS_0_COUNT);
+	osInitPool(&memClass[1], memClass1Buffer, MEM_CLASS_1_SIZE, MEM_CLASS_1_COUNT);
+	osInitPool(&memClass[2], memClass2Buffer, MEM_CLASS_2_SIZE, MEM_CLASS_2_COUNT);
+	osInitPool(&memClass[3], memClass3Buffer, MEM_CLASS_3_SIZE, MEM_CLASS_3_COUNT);
+}
+
+/*************************************************************************************************
+	 *  @brief función que asigna un bloque de memoria
+     *
+     *  @details
+     *   Recorre las clases de tamaño de menor a mayor y entrega un bloque de la primer clase
+     *   que alcance el tamaño pedido y tenga bloques libres. El tiempo de ejecución está acotado
+     *   por la cantidad de clases y no hay fragmentación. Puede ser llamada desde tareas o
+     *   interrupciones.
+     *
+     *   Si la clase que corresponde al tamaño está vacía y el bloque se entrega de una clase
+     *   mayor se incrementa su fallbackCount; su failCount solo se incrementa si ninguna clase
+     *   tiene bloques libres.
+     *
+	 *  @param size, tamaño pedido en bytes
+	 *  @return puntero al bloque o NULL si no hay bloques libres que alcancen el tamaño.
+***************************************************************************************************/
+void* osMemAlloc(uint16_t size)
+{
+	void *block = NULL;
+	memPool *fitClass = NULL;
+	uint8_t i;
+
+	osEnterCritical();
+	for(i = 0; i < MEM_CLASS_QUANTITY && block == NULL; i++)
+	{
+		if(size <= memClass[i].blockSize)
+		{
+			if(fitClass == NULL)
+				fitClass = &memClass[i];
+			block = poolTake(&memClass[i]);
+		}
+	}
+
+	if(fitClass != NULL && block == NULL)
+		fitClass->failCount++;
+	else if(fitClass != NULL && !osPoolContains(fitClass, block))
+		fitClass->fallbackCount++;
+	osExitCritical();
+
+	return block;
+}
+
+/*************************************************************************************************
+	 *  @brief función que libera un bloque obtenido con osMemAlloc
+     *
+     *  @details
+     *   Determina la clase a la que pertenece el bloque por su dirección y lo devuelve a ese
+     *   pool. Puede ser llamada desde tareas o interrupciones.
+     *
+	 *  @param block, bloque que se libera
+	 *  @return none.
+***************************************************************************************************/
+void osMemFree(void *block)
+{
+	uint8_t i;
+
+	for(i = 0; i < MEM_CLASS_QUANTITY; i++)
+	{
+		if(osPoolContains(&memClass[i], block))
+		{
+			osPoolFree(&memClass[i], block);
+			return;
+		}
+	}
+}
+
+/*************************************************************************************************
+	 *  @brief función que obtiene las estadísticas de una clase de tamaño de osMemAlloc
+     *
+	 *  @param memClassIndex, índice de la clase de tamaño
+	 *  @param stats, estructura donde se copian las estadísticas
+	 *  @return bool false si el índice de clase no existe.
+***************************************************************************************************/
+bool osGetMemStats(uint8_t memClassIndex, memPoolStats *stats)
+{
+	if(memClassIndex >= MEM_CLASS_QUANTITY)
+		return false;
+
+	osGetPoolStats(&memClass[memClassIndex], stats);
+	return true;
+}
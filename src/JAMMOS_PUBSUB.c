@@ -0,0 +1,154 @@
+/*
+ * JAMMOS_PUBSUB.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#include "JAMMOS_PUBSUB.h"
+#include "JAMMOS_SET.h"
+#include "JAMMOS_TRACE.h"
+#include <string.h>
+
+/*************************************************************************************************
+	 *  @brief función de inicialización de un tópico
+     *
+     *  @details
+     *   Inicializa el tópico sin publicaciones sobre las ranuras provistas por la aplicación,
+     *   que deben tener lugar para depth publicaciones de size bytes.
+     *
+	 *  @param tp, tópico que se va a inicializar
+	 *  @param slots, almacenamiento de size * depth bytes
+	 *  @param size, tamaño de cada publicación
+	 *  @param depth, cantidad de publicaciones que se conservan para los suscriptores atrasados
+	 *  @return none.
+***************************************************************************************************/
+void osInitTopic(topic *tp, uint8_t *slots, uint16_t size, uint16_t depth)
+{
+	tp->slots = slots;
+	tp->size = size;
+	tp->depth = depth;
+	tp->head = 0;
+	tp->published = 0;
+	tp->waitList = NULL;
+	tp->setWaitList = NULL;
+}
+
+/*************************************************************************************************
+	 *  @brief función que suscribe a un tópico
+     *
+     *  @details
+     *   El suscriptor recibe solo las publicaciones posteriores a la suscripción. Un tópico
+     *   admite cualquier cantidad de suscriptores, la publicación no depende de cuántos haya.
+     *
+	 *  @param sub, suscriptor
+	 *  @param tp, tópico al que se suscribe
+	 *  @return none.
+***************************************************************************************************/
+void osSubscribe(subscriber *sub, topic *tp)
+{
+	osEnterCritical();
+	sub->tp = tp;
+	sub->next = tp->published;
+	sub->lost = 0;
+	osExitCritical();
+}
+
+/*************************************************************************************************
+	 *  @brief función que publica en un tópico
+     *
+     *  @details
+     *   Copia la publicación una sola vez en la próxima ranura del tópico y pasa a READY a
+     *   todos los suscriptores que la esperan, que se ordenan en un único scheduling. La
+     *   función nunca bloquea y puede llamarse desde una interrupción, en ese caso el
+     *   scheduling se pide a la salida del handler si se despertó alguna tarea.
+     *
+	 *  @param tp, tópico donde se publica
+	 *  @param data, publicación de tp->size bytes
+	 *  @return none.
+***************************************************************************************************/
+void osPublish(topic *tp, const void *data)
+{
+	bool woken;
+
+	osEnterCritical();
+	memcpy(tp->slots + tp->head * tp->size, data, tp->size);
+	tp->head = (uint16_t)((tp->head + 1) % tp->depth);
+	tp->published++;
+
+	/*
+	 * El conjunto espera por un suscriptor distinto de los que esperan en el tópico, por lo
+	 * que se despierta siempre
+	 */
+	woken = osBroadcastEvent(&tp->waitList) > 0;
+	woken |= osSignalSet(tp->setWaitList);
+	if(woken && osGetSytemState() == RUN_IRQ)
+		osSetScheduleFromISR(true);
+	osExitCritical();
+
+	OS_TRACE(TRACE_QUEUE_PUT, tp);
+}
+
+/*************************************************************************************************
+	 *  @brief función que lee la próxima publicación de un suscriptor
+     *
+     *  @details
+     *   Si el suscriptor leyó todas las publicaciones la tarea se bloquea hasta la próxima
+     *   publicación o hasta que venza el timeout. Si el suscriptor se atrasó más que la
+     *   cantidad de ranuras del tópico las publicaciones sobrescritas se suman a sub->lost y
+     *   se continúa con la más vieja disponible.
+     *
+     *   Desde una interrupción la función no bloquea.
+     *
+	 *  @param sub, suscriptor que lee
+	 *  @param data, destino de la publicación
+	 *  @param timeout, ticks de espera máxima, OS_WAIT_FOREVER u OS_NO_WAIT
+	 *  @return true si se leyó una publicación, false si venció el timeout.
+***************************************************************************************************/
+bool osReadTopic(subscriber *sub, void *data, uint32_t timeout)
+{
+	topic *tp = sub->tp;
+	uint32_t pending;
+
+	osEnterCritical();
+	/*
+	 * Las publicaciones no se consumen, por lo que al despertar siempre hay una nueva para
+	 * este suscriptor y no hace falta volver a esperar
+	 */
+	if(sub->next == tp->published)
+	{
+		OS_TRACE(TRACE_QUEUE_BLOCK, tp);
+		if(!osWaitEvent(&tp->waitList, timeout))
+		{
+			osExitCritical();
+			OS_TRACE(TRACE_TIMEOUT, tp);
+			return false;
+		}
+	}
+
+	pending = tp->published - sub->next;
+	if(pending > tp->depth)
+	{
+		sub->lost += pending - tp->depth;
+		pending = tp->depth;
+	}
+
+	memcpy(data, tp->slots + ((tp->head + tp->depth - pending) % tp->depth) * tp->size, tp->size);
+	sub->next = tp->published - pending + 1;
+	osExitCritical();
+
+	OS_TRACE(TRACE_QUEUE_GET, tp);
+	return true;
+}
+
+/*************************************************************************************************
+	 *  @brief Atraso de un suscriptor
+     *
+	 *  @param sub, suscriptor
+	 *  @return publicaciones pendientes de leer, puede superar la cantidad de ranuras si el
+	 *  suscriptor ya perdió publicaciones.
+***************************************************************************************************/
+uint32_t osGetSubscriberLag(const subscriber *sub)
+{
+	return sub->tp->published - sub->next;
+}
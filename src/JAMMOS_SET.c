@@ -0,0 +1,228 @@
+/*
+ * JAMMOS_SET.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#include "JAMMOS_SET.h"
+#include "JAMMOS_TRACE.h"
+
+/*************************************************************************************************
+	 *  @brief Lista de espera de conjunto de un objeto
+     *
+	 *  @param member, objeto del conjunto
+	 *  @return puntero al campo setWaitList del objeto.
+***************************************************************************************************/
+static task*** memberSetWaitList(const setMember *member)
+{
+	switch(member->type)
+	{
+	case SET_QUEUE:
+		return &((queue *)member->object)->setWaitList;
+	case SET_SEMAPHORE:
+		return &((semaphore *)member->object)->setWaitList;
+	case SET_STREAM:
+		return &((streamBuffer *)member->object)->setWaitList;
+	default:
+		return &((subscriber *)member->object)->tp->setWaitList;
+	}
+}
+
+/*************************************************************************************************
+	 *  @brief Verifica si un objeto del conjunto puede leerse sin bloquear
+     *
+     *  @details
+     *   Debe llamarse dentro de una sección crítica.
+     *
+	 *  @param member, objeto del conjunto
+	 *  @return true si el objeto está listo.
+***************************************************************************************************/
+static bool memberReady(const setMember *member)
+{
+	const queue *que;
+	const streamBuffer *sb;
+	const subscriber *sub;
+
+	switch(member->type)
+	{
+	case SET_QUEUE:
+		que = member->object;
+		return que->head != que->tail;
+	case SET_SEMAPHORE:
+		return ((const semaphore *)member->object)->state == RELEASED;
+	case SET_STREAM:
+		sb = member->object;
+		return sb->count > 0 && sb->count >= sb->triggerLevel;
+	default:
+		sub = member->object;
+		return sub->next != sub->tp->published;
+	}
+}
+
+/*************************************************************************************************
+	 *  @brief función de inicialización de un conjunto
+     *
+	 *  @param set, conjunto que se va a inicializar
+	 *  @return none.
+***************************************************************************************************/
+void osInitQueueSet(queueSet *set)
+{
+	set->quantity = 0;
+	set->waitList = NULL;
+}
+
+/*************************************************************************************************
+	 *  @brief función que agrega un objeto a un conjunto
+     *
+     *  @details
+     *   El objeto debe estar inicializado. Para volver a inicializarlo primero debe quitarse
+     *   del conjunto con osRemoveFromQueueSet: su inicialización solo borra la lista de espera
+     *   del conjunto que guarda el objeto, que sigue en members[]. Los objetos se revisan en el
+     *   orden en que se agregaron, por lo que el primero tiene preferencia cuando varios están
+     *   listos a la vez. Para un suscriptor el conjunto se asocia a su tópico, que solo puede
+     *   tener suscriptores en un conjunto.
+     *
+	 *  @param set, conjunto
+	 *  @param type, tipo del objeto
+	 *  @param object, queue, semaphore, streamBuffer, messageBuffer o subscriber
+	 *  @return true si se agregó el objeto, false si el conjunto está lleno o el objeto ya
+	 *  pertenece a otro conjunto.
+***************************************************************************************************/
+bool osAddToQueueSet(queueSet *set, setMemberType type, void *object)
+{
+	task ***setWaitList;
+	bool added = false;
+
+	osEnterCritical();
+	if(set->quantity < QUEUE_SET_SIZE)
+	{
+		set->members[set->quantity].type = type;
+		set->members[set->quantity].object = object;
+		setWaitList = memberSetWaitList(&set->members[set->quantity]);
+
+		if(*setWaitList == NULL || *setWaitList == &set->waitList)
+		{
+			*setWaitList = &set->waitList;
+			set->quantity++;
+			added = true;
+		}
+	}
+	osExitCritical();
+
+	return added;
+}
+
+/*************************************************************************************************
+	 *  @brief función que quita un objeto de un conjunto
+     *
+     *  @details
+     *   Compacta members[] conservando el orden de preferencia de los objetos restantes. La
+     *   lista de espera del conjunto que guarda el objeto se borra salvo que otro suscriptor
+     *   del mismo tópico siga en el conjunto.
+     *
+	 *  @param set, conjunto
+	 *  @param object, objeto agregado con osAddToQueueSet
+	 *  @return true si se quitó el objeto, false si no pertenece al conjunto.
+***************************************************************************************************/
+bool osRemoveFromQueueSet(queueSet *set, void *object)
+{
+	task ***setWaitList = NULL;
+	bool shared = false;
+	uint8_t i;
+	uint8_t j = 0;
+
+	osEnterCritical();
+	for(i = 0; i < set->quantity; i++)
+	{
+		if(set->members[i].object == object && setWaitList == NULL)
+			setWaitList = memberSetWaitList(&set->members[i]);
+		else
+			set->members[j++] = set->members[i];
+	}
+	set->quantity = j;
+
+	if(setWaitList != NULL)
+	{
+		for(i = 0; i < set->quantity; i++)
+			if(memberSetWaitList(&set->members[i]) == setWaitList)
+				shared = true;
+		if(!shared && *setWaitList == &set->waitList)
+			*setWaitList = NULL;
+	}
+	osExitCritical();
+
+	return setWaitList != NULL;
+}
+
+/*************************************************************************************************
+	 *  @brief función que espera que algún objeto del conjunto esté listo
+     *
+     *  @details
+     *   Si ningún objeto está listo la tarea se bloquea en el conjunto hasta que se escriba,
+     *   libere o publique en alguno de ellos o venza el timeout. La función no lee el objeto:
+     *   la tarea lo lee luego con su API y timeout OS_NO_WAIT, que puede fallar si otra tarea
+     *   lo leyó primero. Está pensado para una única tarea lectora por objeto.
+     *
+     *   Desde una interrupción la función no bloquea.
+     *
+	 *  @param set, conjunto
+	 *  @param timeout, ticks de espera máxima, OS_WAIT_FOREVER u OS_NO_WAIT
+	 *  @return objeto listo, NULL si venció el timeout.
+***************************************************************************************************/
+void* osWaitQueueSet(queueSet *set, uint32_t timeout)
+{
+	uint32_t deadline = osGetTickCount() + timeout;
+	uint32_t wait = timeout;
+	void *ready = NULL;
+	uint8_t i;
+
+	osEnterCritical();
+	while(1)
+	{
+		for(i = 0; i < set->quantity && ready == NULL; i++)
+			if(memberReady(&set->members[i]))
+				ready = set->members[i].object;
+
+		if(ready != NULL)
+			break;
+
+		OS_TRACE(TRACE_QUEUE_BLOCK, set);
+		if(!osWaitEvent(&set->waitList, wait))
+			break;
+
+		/*
+		 * Si otra tarea leyó el objeto que despertó al conjunto se vuelve a esperar solo el
+		 * tiempo restante hasta el tick límite
+		 */
+		if(timeout != OS_WAIT_FOREVER)
+		{
+			wait = deadline - osGetTickCount();
+			if((int32_t)wait <= 0)
+				wait = OS_NO_WAIT;
+		}
+	}
+	osExitCritical();
+
+	if(ready == NULL)
+		OS_TRACE(TRACE_TIMEOUT, set);
+
+	return ready;
+}
+
+/*************************************************************************************************
+	 *  @brief Despierta a la tarea que espera en el conjunto de un objeto
+     *
+     *  @details
+     *   La llaman los objetos miembro cuando pasan a estar listos y no despertaron a una tarea
+     *   que los esperaba directamente. Debe llamarse dentro de una sección crítica, puede
+     *   llamarse desde una interrupción.
+     *
+	 *  @param setWaitList, lista de espera del conjunto del objeto, o NULL si no pertenece a
+	 *  un conjunto
+	 *  @return true si se despertó una tarea.
+***************************************************************************************************/
+bool osSignalSet(task **setWaitList)
+{
+	return setWaitList != NULL && osSignalEvent(setWaitList);
+}
@@ -0,0 +1,128 @@
+/*
+ * JAMMOS_TRACE.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#include "JAMMOS_TRACE.h"
+
+#if JAMMOS_TRACE
+
+static traceEvent traceBuffer[TRACE_BUFFER_SIZE];
+static uint32_t traceCount = 0;			//cantidad total de eventos registrados
+static bool traceEnabled = true;
+
+static void putWord(tracePutByte putByte, uint32_t value, uint8_t size);
+
+/*************************************************************************************************
+	 *  @brief Registra un evento en el buffer de trace
+     *
+     *  @details
+     *   Escribe el evento en la siguiente posición del buffer circular, sobrescribiendo el
+     *   evento más antiguo cuando el buffer está lleno. Solo enmascara las interrupciones
+     *   guardando y restaurando su estado (PRIMASK en Cortex-M), de esta forma puede llamarse
+     *   desde tareas, interrupciones y dentro de secciones críticas sin alterar el contador de
+     *   osEnterCritical.
+     *
+	 *  @param event	Identificador del evento (traceEventId o mayor a TRACE_USER)
+	 *  @param arg		Argumento del evento
+	 *  @return none.
+***************************************************************************************************/
+void osTraceRecord(uint8_t event, uint32_t arg)
+{
+	portIrqState irqState;
+	traceEvent *ev;
+	task *currentTask;
+
+	if(!traceEnabled)
+		return;
+
+	irqState = portSaveAndDisableIrq();
+
+	ev = &traceBuffer[traceCount & (TRACE_BUFFER_SIZE - 1)];
+	traceCount++;
+
+	ev->timestamp = portGetCycles();
+	ev->event = event;
+	currentTask = getCurrentTask();
+	ev->taskId = currentTask != NULL ? currentTask->id : TRACE_NO_TASK;
+	ev->arg = arg;
+
+	portRestoreIrq(irqState);
+}
+
+/*************************************************************************************************
+	 *  @brief Habilita o congela el registro de eventos
+     *
+     *  @details
+     *   Permite congelar el buffer al detectar una anomalía (por ejemplo desde errorHook) para
+     *   conservar la historia previa hasta que se vuelque.
+     *
+	 *  @param enable	true para registrar eventos, false para congelar el buffer
+	 *  @return none.
+***************************************************************************************************/
+void osTraceEnable(bool enable)
+{
+	traceEnabled = enable;
+}
+
+/*************************************************************************************************
+	 *  @brief Vuelca el buffer de trace en formato binario
+     *
+     *  @details
+     *   Envía byte a byte, en little endian, un encabezado con el identificador "JTRC", la
+     *   versión, la cantidad de eventos y la frecuencia del CPU, seguido de los eventos del más
+     *   antiguo al más reciente, de 10 bytes cada uno (marca de tiempo, evento, tarea y arg). El registro se congela durante el volcado. El archivo
+     *   resultante se decodifica con tools/jammos_trace.py.
+     *
+	 *  @param putByte	Función que envía cada byte (UART, semihosting, etc)
+	 *  @return none.
+***************************************************************************************************/
+void osTraceDump(tracePutByte putByte)
+{
+	bool previousEnabled = traceEnabled;
+	uint32_t first;
+	uint32_t quantity;
+	uint32_t i;
+	traceEvent *ev;
+
+	traceEnabled = false;
+
+	quantity = traceCount < TRACE_BUFFER_SIZE ? traceCount : TRACE_BUFFER_SIZE;
+	first = traceCount - quantity;
+
+	putWord(putByte, TRACE_MAGIC, 4);
+	putWord(putByte, TRACE_VERSION, 2);
+	putWord(putByte, quantity, 2);
+	putWord(putByte, portCpuFrequency(), 4);
+
+	for(i = first; i < traceCount; i++)
+	{
+		ev = &traceBuffer[i & (TRACE_BUFFER_SIZE - 1)];
+		putWord(putByte, ev->timestamp, 4);
+		putByte(ev->event);
+		putByte(ev->taskId);
+		putWord(putByte, ev->arg, 4);
+	}
+
+	traceEnabled = previousEnabled;
+}
+
+/*************************************************************************************************
+	 *  @brief Envía un valor en little endian
+     *
+	 *  @param putByte	Función que envía cada byte
+	 *  @param value	Valor a enviar
+	 *  @param size		Cantidad de bytes del valor
+	 *  @return none.
+***************************************************************************************************/
+static void putWord(tracePutByte putByte, uint32_t value, uint8_t size)
+{
+	uint8_t i;
+
+	for(i = 0; i < size; i++)
+		putByte((uint8_t)(value >> (8 * i)));
+}
+
+#endif
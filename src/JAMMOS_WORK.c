@@ -0,0 +1,162 @@
+/*
+ * JAMMOS_WORK.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#include "JAMMOS_WORK.h"
+
+static workQueue* workQueueList[MAX_WORK_QUEUES];
+static uint8_t quantityWorkQueue = 0;
+
+static void workerTask(void);
+
+/*************************************************************************************************
+	 *  @brief función de inicialicación de una cola de trabajo
+     *
+     *  @details
+     *   Esta función inicializa la cola de trabajo y la tarea worker asociada que se encarga de
+     *   ejecutar los trabajos que las interrupciones depositan en la cola. La tarea worker se
+     *   inicializa con osInitTask, por lo que esta función debe llamarse antes de osInit y la
+     *   tarea debe declararse con OS_TASK.
+     *
+     *   Varias interrupciones pueden compartir una misma cola de trabajo y por lo tanto un
+     *   único stack de tarea worker.
+     *
+     *   Si ya hay MAX_WORK_QUEUES colas la cola queda sin tarea worker y osPostWork la rechaza.
+     *
+	 *  @param wq, cola de trabajo que se va a inicializar
+	 *  @param worker, estructura de la tarea worker que vacía la cola
+	 *  @param priority, prioridad de la tarea worker
+	 *  @return true si se inicializó la cola, false si se superó MAX_WORK_QUEUES.
+***************************************************************************************************/
+bool osInitWorkQueue(workQueue *wq, task *worker, uint8_t priority)
+{
+	wq->head = 0;
+	wq->tail = 0;
+	wq->workerTask = NULL;
+	wq->waitList = NULL;
+	wq->lostWork = 0;
+
+	if(quantityWorkQueue >= MAX_WORK_QUEUES)
+		return false;
+
+	wq->workerTask = worker;
+	workQueueList[quantityWorkQueue] = wq;
+	quantityWorkQueue++;
+	osInitTask(workerTask, worker, priority);
+
+	return true;
+}
+
+/*************************************************************************************************
+	 *  @brief función que deposita un trabajo en la cola de trabajo
+     *
+     *  @details
+     *   Esta función puede llamarse desde una interrupción o desde una tarea. Copia la función
+     *   y su argumento en la cola y, si la tarea worker esperaba trabajo en la lista de espera
+     *   de la cola, la despierta. Si se llama desde una interrupción se pide un scheduling a la
+     *   salida del handler, de esta forma el tiempo dentro de la ISR es mínimo.
+     *
+	 *  @param wq, cola de trabajo donde se deposita el trabajo
+	 *  @param function, función que ejecutará la tarea worker
+	 *  @param arg, argumento que recibe la función
+	 *  @return bool true si el trabajo se depositó, false si la cola estaba llena o no tiene
+	 *  tarea worker.
+***************************************************************************************************/
+bool osPostWork(workQueue *wq, workFunction function, void *arg)
+{
+	bool postOk = false;
+	bool woken = false;
+	task* currentTask;
+
+	if(wq->workerTask == NULL)
+		return false;
+
+	osEnterCritical();
+	/*
+	 * Se verifica que la cola tenga lugar, si está llena el trabajo se descarta y se
+	 * incrementa el contador de trabajos perdidos
+	 * */
+	if((wq->head + 1) % WORK_QUEUE_SIZE != wq->tail)
+	{
+		wq->items[wq->head].function = function;
+		wq->items[wq->head].arg = arg;
+		wq->head = (wq->head + 1) % WORK_QUEUE_SIZE;
+		postOk = true;
+		woken = osSignalEvent(&wq->waitList);
+	}
+	else
+		wq->lostWork++;
+	osExitCritical();
+
+	if(woken)
+	{
+		/*
+		 * Desde una interrupción se deja pendiente el scheduling para la salida del handler.
+		 * Desde una tarea solo se fuerza el scheduling si la tarea worker tiene mayor prioridad
+		 * */
+		if(osGetSytemState() == RUN_IRQ)
+			osSetScheduleFromISR(true);
+		else
+		{
+			currentTask = getCurrentTask();
+			if(currentTask != NULL && wq->workerTask->priority < currentTask->priority)
+				osForceSchCC();
+		}
+	}
+
+	return postOk;
+}
+
+/*************************************************************************************************
+	 *  @brief Tarea worker de las colas de trabajo
+     *
+     *  @details
+     *   Cuerpo común de todas las tareas worker. Busca la cola de trabajo que le corresponde a
+     *   la tarea actual y la vacía por lotes: toma todos los trabajos pendientes al momento de
+     *   despertar y los ejecuta fuera de la sección crítica. Cuando la cola queda vacía la
+     *   tarea espera en la lista de espera de la cola hasta que osPostWork deposite un nuevo
+     *   trabajo.
+     *
+	 *  @param none
+	 *  @return none.
+***************************************************************************************************/
+static void workerTask(void)
+{
+	workQueue *wq = NULL;
+	task* currentTask;
+	uint16_t head;
+	uint8_t i;
+
+	currentTask = getCurrentTask();
+	for(i = 0; i < quantityWorkQueue; i++)
+	{
+		if(workQueueList[i]->workerTask == currentTask)
+			wq = workQueueList[i];
+	}
+
+	while(1)
+	{
+		osEnterCritical();
+		/*
+		 * Si no hay trabajos pendientes la tarea espera dentro de la sección crítica, así
+		 * ninguna interrupción puede depositar un trabajo entre la verificación y el bloqueo
+		 * */
+		while(wq->head == wq->tail)
+			osWaitEvent(&wq->waitList, OS_WAIT_FOREVER);
+		head = wq->head;
+		osExitCritical();
+
+		/*
+		 * Se ejecuta el lote de trabajos pendientes hasta el índice head leído. El índice
+		 * tail solo lo modifica la tarea worker, por lo que no necesita sección crítica
+		 * */
+		while(wq->tail != head)
+		{
+			wq->items[wq->tail].function(wq->items[wq->tail].arg);
+			wq->tail = (wq->tail + 1) % WORK_QUEUE_SIZE;
+		}
+	}
+}
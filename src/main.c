@@ -5,15 +5,18 @@
 #include "JAMMOS.h"
 #include "JAMMOS_API.h"
 #include "JAMMOS_IRQ.h"
+#include "JAMMOS_MEM.h"
+#include "JAMMOS_PUBSUB.h"
+#include "JAMMOS_SET.h"
 #include "sapi.h"
 #include <string.h>
 
 
 /*==================[macros and definitions]=================================*/
 
-#define MILISEC		1000
 
 #define MAX_MSG_LENGTH 250
+#define BUTTON_TOPIC_DEPTH 8
 
 /*==================[Declaracion de prioridades]==============================*/
 
@@ -32,12 +35,6 @@
 
 #define nBLINK	10
 
-task g_taskFallingEdge,g_taskRisingEdge, g_taskEvent,g_taskSendUart; //Se declaran tareas
-
-queue queueButtonFallingEdge, queueButtonRisingEdge, queueEvent, queueUart; //Se declaran Colas
-
-uint32_t timeMseconds; //Variable de tiempo que se incrementa en cada tickHook renombrada por el usuario
-
 /*
  * Tipo de dato de id del botón que tiene la información del botón que tuvo evento
  * */
@@ -61,11 +58,13 @@ typedef enum _modeEdge modeEdge;
 /*
  * Definición del tipo de dato button que es una estructura que tiene el Id de identificación del
  * botón el tiempo en que ha tenido el último evento y guarda el modo de flanco del último evento
+ *
+ * El tiempo se toma de la base de tiempo del OS (osGetTimeNs) en microsegundos
  */
 
 struct _button{
 	buttonId id;
-	uint32_t time;
+	uint64_t time;
 	modeEdge mEdge;
 };
 typedef struct _button button;
@@ -90,10 +89,37 @@ typedef enum _modeEvent modeEvent;
 struct _event{
 	modeEvent mEvent;
 	modeEdge mEdge;
-	uint32_t time;
+	uint32_t time;			//tiempo entre los flancos de los dos botones en microsegundos
 };
 typedef struct _event event;
 
+/*
+ * Estado del procesamiento de las pulsaciones de un flanco: la pulsación anterior y la cantidad
+ * de pulsaciones recibidas del par actual
+ */
+
+struct _edgeState{
+	button btnPrevious;
+	uint8_t nBtn;
+};
+typedef struct _edgeState edgeState;
+
+/*
+ * Las colas, los tópicos y las tareas (al final del archivo, luego de sus funciones) se declaran
+ * como datos inicializados, el arranque no las inicializa.
+ *
+ * Las interrupciones de los botones publican cada pulsación en el tópico de su flanco sin
+ * conocer a sus consumidores. La tarea taskEdge atiende los dos tópicos esperando en el
+ * conjunto setEdges, que se arma en main
+ */
+OS_TOPIC_STATIC(topicFallingEdge, sizeof(button), BUTTON_TOPIC_DEPTH);
+OS_TOPIC_STATIC(topicRisingEdge, sizeof(button), BUTTON_TOPIC_DEPTH);
+OS_SUBSCRIBER_STATIC(subFallingEdge, topicFallingEdge);
+OS_SUBSCRIBER_STATIC(subRisingEdge, topicRisingEdge);
+static queueSet setEdges;
+OS_QUEUE_STATIC(queueEvent, sizeof(event*));
+OS_MESSAGE_BUFFER_STATIC(uartMessages, 2 * (MAX_MSG_LENGTH + MESSAGE_HEADER_SIZE));
+
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
@@ -117,8 +143,7 @@ void b2_high_ISR(void);
  */
 static void initHardware(void)  {
 	Board_Init();
-	SystemCoreClockUpdate();
-	SysTick_Config(SystemCoreClock / MILISEC);		//systick 1ms
+	SystemCoreClockUpdate();						//el SysTick lo arranca osInit (portInit)
 
 	/*
 	 * Se configura la interrupcion 0 para el flanco descendente en la tecla 1
@@ -159,108 +184,76 @@ static void initHardware(void)  {
 /*==================[Definicion de tareas para el OS]==========================*/
 
 /*
- * En esta tarea espera un dato de la cola queueButtonFallingEdge proveniente de las interrupciones
- * de flanco descendiente b1_low_ISR y b2_low_ISR.
+ * Procesa una pulsación de un flanco con el estado de ese flanco.
  *
- * Cuando se ha realizado dos pulsaciones de flanco descendiente de los botones verifica si los dos flancos
- * son descendientes, verifica el orden de pulsación para configurar la variable modo del Evento (ev.mEvent)
- * y asigna el tiempo entre pulsaciónes de los botones. Si el evento es válido envía la información del evento a
- * la tarea taskEvent por medio de la cola queueEvent
+ * Cuando se ha realizado dos pulsaciones del mismo flanco de los botones verifica el orden de pulsación
+ * para configurar la variable modo del Evento (ev.mEvent) y asigna el tiempo entre pulsaciónes de los
+ * botones. Si el evento es válido envía la información del evento a la tarea taskEvent por medio de la
+ * cola queueEvent
  * */
-void taskFallingEdge(void)  {
-	button btn, btnPrevious;
-	uint8_t nBtn = 0;
-	event ev;
+static void processEdge(edgeState *st, const button *btn)  {
+	event *ev;
+
+	if(st->nBtn == 0)
+	{
+		st->btnPrevious = *btn;
+		st->nBtn++;
+		return;
+	}
 
-	while (1) {
-		osGetQueue(&queueButtonFallingEdge,&btn);
-		if(nBtn == 0)
+	ev = osMemAlloc(sizeof(event));
+	if(ev != NULL && st->btnPrevious.mEdge == btn->mEdge)
+	{
+		ev->mEdge = btn->mEdge;
+		if(st->btnPrevious.id == B1 && btn->id == B2)
+		{
+			ev->mEvent = B1_B2;
+			ev->time = (uint32_t)(btn->time - st->btnPrevious.time);
+		}
+		else if(st->btnPrevious.id == B2 && btn->id == B1)
 		{
-			btnPrevious.id = btn.id;
-			btnPrevious.mEdge = btn.mEdge;
-			btnPrevious.time = btn.time;
-			nBtn++;
+			ev->mEvent = B2_B1;
+			ev->time = (uint32_t)(btn->time - st->btnPrevious.time);
 		}
 		else
 		{
-			if(btnPrevious.mEdge == FALLING_EDGE && btn.mEdge == FALLING_EDGE)
-			{
-				ev.mEdge = FALLING_EDGE;
-				if(btnPrevious.id == B1 && btn.id == B2)
-				{
-					ev.mEvent = B1_B2;
-					ev.time = btn.time - btnPrevious.time;
-				}
-				else if(btnPrevious.id == B2 && btn.id == B1)
-				{
-					ev.mEvent = B2_B1;
-					ev.time = btn.time - btnPrevious.time;
-				}
-				else
-				{
-					ev.mEvent = INVALID;
-					ev.time = 0;
-				}
-				if(ev.mEvent != INVALID)
-					osPutQueue(&queueEvent,&ev);
-			}
-			nBtn = 0;
+			ev->mEvent = INVALID;
+			ev->time = 0;
+		}
+		if(ev->mEvent != INVALID)
+		{
+			osPutQueue(&queueEvent,&ev,OS_WAIT_FOREVER);
+			ev = NULL;
 		}
 	}
+	osMemFree(ev);
+	st->nBtn = 0;
 }
 
 /*
- * En esta tarea espera un dato de la cola queueButtonRisingEdge proveniente de las interrupciones
- * de flanco ascendente b1_high_ISR y b2_high_ISR.
+ * En esta tarea espera en el conjunto setEdges las pulsaciones publicadas en los tópicos
+ * topicFallingEdge (b1_low_ISR y b2_low_ISR) y topicRisingEdge (b1_high_ISR y b2_high_ISR) y
+ * procesa cada una con el estado de su flanco.
  *
- * Cuando se ha realizado dos pulsaciones de flanco ascendente de los botones verifica si los dos flancos
- * son ascendentes, verifica el orden de pulsación para configurar la variable modo del Evento (ev.mEvent)
- * y asigna el tiempo entre pulsaciónes de los botones. Si el evento es válido envía la información del evento a
- * la tarea taskEvent por medio de la cola queueEvent
+ * Una sola tarea, con un solo stack, atiende los dos flancos
  * */
-void taskRisingEdge(void)  {
-	button btn, btnPrevious;
-	uint8_t nBtn = 0;
-	event ev;
+void taskEdge(void)  {
+	edgeState falling = { .nBtn = 0 };
+	edgeState rising = { .nBtn = 0 };
+	button btn;
+	void *ready;
 
 	while (1) {
-		osGetQueue(&queueButtonRisingEdge,&btn);
-		if(nBtn == 0)
-		{
-			btnPrevious.id = btn.id;
-			btnPrevious.mEdge = btn.mEdge;
-			btnPrevious.time = btn.time;
-			nBtn++;
-		}
-		else
-		{
-			if(btnPrevious.mEdge == RISING_EDGE && btn.mEdge == RISING_EDGE)
-			{
-				ev.mEdge = RISING_EDGE;
-				if(btnPrevious.id == B1 && btn.id == B2)
-				{
-					ev.mEvent = B1_B2;
-					ev.time = btn.time - btnPrevious.time;
-				}
-				else if(btnPrevious.id == B2 && btn.id == B1)
-				{
-					ev.mEvent = B2_B1;
-					ev.time = btn.time - btnPrevious.time;
-				}
-				else
-				{
-					ev.mEvent = INVALID;
-					ev.time = 0;
-				}
-				if(ev.mEvent != INVALID)
-					osPutQueue(&queueEvent,&ev);
-			}
-			nBtn = 0;
-		}
+		ready = osWaitQueueSet(&setEdges, OS_WAIT_FOREVER);
+		if(ready == &subFallingEdge && osReadTopic(&subFallingEdge, &btn, OS_NO_WAIT))
+			processEdge(&falling, &btn);
+		else if(ready == &subRisingEdge && osReadTopic(&subRisingEdge, &btn, OS_NO_WAIT))
+			processEdge(&rising, &btn);
 	}
 }
+
 /*
- * Esta tarea recibe de las tareas taskFallingEdge y taskRisingEdge eventos producidos por los botones y su órden de ejecución.
+ * Esta tarea recibe de la tarea taskEdge eventos producidos por los botones y su órden de ejecución.
  * Cuando recibe dos eventos verifica que el orden del evento anterior y el evento actual estén en la correcta secuencia.
  * primero de flanco Descendente y después de flanco Ascendente.
  *
@@ -269,103 +262,96 @@ void taskRisingEdge(void)  {
  * eventos anterior y actual.
  *
  * Guarda en una cadena de caracteres dependiendo de los ordenes expuestos anteriormente y arma el string del mensaje
- * para después ser enviados a la tarea taskSendUart por medio de la cola queueUart que escribe por el usart cada caracter
- * que detecta en la lectura de la cola.
+ * para después ser enviado completo a la tarea taskSendUart por medio del buffer de mensajes uartMessages, que lo
+ * escribe por el usart.
  *
  * */
 void taskEvent(void)  {
-	event ev, evPrevious;
+	event *ev, evPrevious;
 	uint8_t nEv = 0;
 	uint32_t tTotal = 0;
 	char message[MAX_MSG_LENGTH];
 	char msgColor[10];
-	uint16_t msgIndex = 0;
 
 
 	while(1)  {
-		osGetQueue(&queueEvent,&ev);
+		osGetQueue(&queueEvent,&ev,OS_WAIT_FOREVER);
 		if(nEv == 0)
 		{
-			evPrevious.mEdge = ev.mEdge;
-			evPrevious.mEvent = ev.mEvent;
-			evPrevious.time = ev.time;
+			evPrevious.mEdge = ev->mEdge;
+			evPrevious.mEvent = ev->mEvent;
+			evPrevious.time = ev->time;
 			nEv++;
 		}
 		else
 		{
-			if(evPrevious.mEdge == FALLING_EDGE && ev.mEdge == RISING_EDGE)
+			if(evPrevious.mEdge == FALLING_EDGE && ev->mEdge == RISING_EDGE)
 			{
-				tTotal = evPrevious.time + ev.time;
+				tTotal = evPrevious.time + ev->time;
 
-				if(evPrevious.mEvent == B1_B2 && ev.mEvent == B1_B2)
+				if(evPrevious.mEvent == B1_B2 && ev->mEvent == B1_B2)
 				{
 					gpioWrite(LEDG,true);
-					osDelay(tTotal);
+					osDelay(tTotal / (1000000 / OS_TICK_HZ));
 					gpioWrite(LEDG,false);
 					strcpy( msgColor, "Verde" );
 				}
 
-				if(evPrevious.mEvent == B1_B2 && ev.mEvent == B2_B1)
+				if(evPrevious.mEvent == B1_B2 && ev->mEvent == B2_B1)
 				{
 					gpioWrite(LEDR,true);
-					osDelay(tTotal);
+					osDelay(tTotal / (1000000 / OS_TICK_HZ));
 					gpioWrite(LEDR,false);
 					strcpy( msgColor, "Rojo" );
 				}
 
-				if(evPrevious.mEvent == B2_B1 && ev.mEvent == B1_B2)
+				if(evPrevious.mEvent == B2_B1 && ev->mEvent == B1_B2)
 				{
 					gpioWrite(LEDR,true);
 					gpioWrite(LEDG,true);
-					osDelay(tTotal);
+					osDelay(tTotal / (1000000 / OS_TICK_HZ));
 					gpioWrite(LEDR,false);
 					gpioWrite(LEDG,false);
 					strcpy( msgColor, "Amarillo" );
 				}
 
-				if(evPrevious.mEvent == B2_B1 && ev.mEvent == B2_B1)
+				if(evPrevious.mEvent == B2_B1 && ev->mEvent == B2_B1)
 				{
 					gpioWrite(LEDB,true);
-					osDelay(tTotal);
+					osDelay(tTotal / (1000000 / OS_TICK_HZ));
 					gpioWrite(LEDB,false);
 					strcpy( msgColor, "Azúl" );
 				}
 
-				sprintf( message, "Led %s encendido:\n\r\t Tiempo encendido: %lu ms\n\r\t Tiempo entre flancos descendentes: %lu ms \n\r\t Tiempo entre flancos ascendentes: %lu ms \n\r", msgColor, tTotal, evPrevious.time,ev.time );
+				sprintf( message, "Led %s encendido:\n\r\t Tiempo encendido: %lu us\n\r\t Tiempo entre flancos descendentes: %lu us \n\r\t Tiempo entre flancos ascendentes: %lu us \n\r", msgColor, tTotal, evPrevious.time,ev->time );
 
-				msgIndex = 0;
-				while(message[msgIndex] != NULL)  {
-					osPutQueue(&queueUart,(message + msgIndex));
-					msgIndex++;
-				}
+				osSendMessage(&uartMessages, message, strlen(message), OS_WAIT_FOREVER);
 			}
 			nEv = 0;
 		}
+		osMemFree(ev);
 	}
 }
 
 /*
- * Tarea que recibe cada caracter proveniente de la tarea taskEvent para ser escrita al buffer del Usart
+ * Tarea que recibe cada mensaje completo proveniente de la tarea taskEvent para ser escrito al buffer del Usart.
+ * La tarea se despierta una vez por mensaje y no por cada caracter
  *
  * */
 void taskSendUart(void)  {
-	char ch;
+	char message[MAX_MSG_LENGTH];
+	uint16_t length;
+	uint16_t i;
+
 	while(1)  {
-		osGetQueue(&queueUart,&ch);
-		uartWriteByte(UART_USB,ch);
+		length = osReceiveMessage(&uartMessages, message, sizeof(message), OS_WAIT_FOREVER);
+		if(length == MESSAGE_DISCARDED)
+			continue;
+		for(i = 0; i < length; i++)
+			uartWriteByte(UART_USB, message[i]);
 	}
 }
 
-/**
- * Redefinición de la función hook que se llama en el sistick que lleva la temporizacio de cuantos milisegundo transcurren
- *
- */
-
-void tickHook(void)
-{
-	timeMseconds++;
-}
-
 /*============================================================================*/
 /*
  * Descripción de la prueba para examen de la materia ISO1 con el sistema operativo JAMMOS
@@ -378,20 +364,28 @@ void tickHook(void)
  * descendentes respectivamente.
  * */
 
+#define APP_TASKS(TASK)										\
+	TASK(g_taskEdge, taskEdge, PRIORITY_0)					\
+	TASK(g_taskEvent, taskEvent, PRIORITY_1)				\
+	TASK(g_taskSendUart, taskSendUart, PRIORITY_3)
+
+OS_TASK_TABLE(appTasks, APP_TASKS);
+
 int main(void)  {
 
 	initHardware();
 
-	osInitTask(taskFallingEdge, &g_taskFallingEdge, PRIORITY_0);
-	osInitTask(taskRisingEdge, &g_taskRisingEdge, PRIORITY_0);
-	osInitTask(taskEvent, &g_taskEvent, PRIORITY_1);
-	osInitTask(taskSendUart, &g_taskSendUart, PRIORITY_3);
+	osInitTaskTable(&appTasks);
 
-	osInitQueue(&queueButtonFallingEdge,sizeof(button));
-	osInitQueue(&queueButtonRisingEdge,sizeof(button));
+	/*
+	 * La tarea de flancos tiene la máxima prioridad, se limita su tiempo de CPU a 1 ms cada
+	 * 10 ticks para que una ráfaga de pulsaciones no impida ejecutar al resto de las tareas
+	 */
+	osSetTaskBudget(&g_taskEdge, 1000, 10);
 
-	osInitQueue(&queueEvent,sizeof(event));
-	osInitQueue(&queueUart,sizeof(char));
+	osInitQueueSet(&setEdges);
+	osAddToQueueSet(&setEdges, SET_SUBSCRIBER, &subFallingEdge);
+	osAddToQueueSet(&setEdges, SET_SUBSCRIBER, &subRisingEdge);
 
 	osInstallIRQ(PIN_INT0_IRQn, b1_low_ISR);
 	osInstallIRQ(PIN_INT1_IRQn, b1_high_ISR);
@@ -400,51 +394,47 @@ int main(void)  {
 
 	osInit();
 
-	timeMseconds = 0; //Variable rollover que lleva el trancurso del tiempo
-
 	while (1) {}
 }
 
 /*
- * Tareas que que se asocian a la interrupciones de cada uno de los botones, se arma una
+ * Funciones que que se asocian a la interrupciones de cada uno de los botones, se arma una
  * estructura button con la información del la pulsación de cada botón para ser procesadas
- * en las tareas taskFallingEdge y taskRisingEdge
+ * en la tarea taskEdge
+ *
+ * La estructura se publica por valor en el tópico de su flanco: se copia una sola vez y cada
+ * suscriptor la lee con su propio índice. La publicación no bloquea, si la tarea se atrasa más
+ * de BUTTON_TOPIC_DEPTH pulsaciones pierde las más viejas
  *
  * */
 
-void b1_low_ISR(void){
+static void publishButton(buttonId id, modeEdge edge)
+{
 	button btn;
-	btn.id = B1;
-	btn.mEdge = FALLING_EDGE;
-	btn.time = timeMseconds;
-	osPutQueue(&queueButtonFallingEdge,&btn);
+
+	btn.id = id;
+	btn.mEdge = edge;
+	btn.time = osGetTimeNs() / 1000;
+	osPublish(edge == FALLING_EDGE ? &topicFallingEdge : &topicRisingEdge, &btn);
+}
+
+void b1_low_ISR(void){
+	publishButton(B1, FALLING_EDGE);
 	Chip_PININT_ClearIntStatus( LPC_GPIO_PIN_INT, PININTCH( 0 ) );
 }
 
 void b1_high_ISR(void){
-	button btn;
-	btn.id = B1;
-	btn.mEdge = RISING_EDGE;
-	btn.time = timeMseconds;
-	osPutQueue(&queueButtonRisingEdge,&btn);
+	publishButton(B1, RISING_EDGE);
 	Chip_PININT_ClearIntStatus( LPC_GPIO_PIN_INT, PININTCH( 1 ) );
 }
 
 void b2_low_ISR(void){
-	button btn;
-	btn.id = B2;
-	btn.mEdge = FALLING_EDGE;
-	btn.time = timeMseconds;
-	osPutQueue(&queueButtonFallingEdge,&btn);
+	publishButton(B2, FALLING_EDGE);
 	Chip_PININT_ClearIntStatus( LPC_GPIO_PIN_INT, PININTCH( 2 ) );
 }
 
 void b2_high_ISR(void){
-	button btn;
-	btn.id = B2;
-	btn.mEdge = RISING_EDGE;
-	btn.time = timeMseconds;
-	osPutQueue(&queueButtonRisingEdge,&btn);
+	publishButton(B2, RISING_EDGE);
 	Chip_PININT_ClearIntStatus( LPC_GPIO_PIN_INT, PININTCH( 3 ) );
 }
 
@@ -0,0 +1,336 @@
+/*
+ * test_scheduler.c
+ *
+ *  Pruebas del scheduler de JAMMOS sobre el port de prueba (port/test)
+ *
+ *  Cada prueba arma una configuración de tareas con osTestReset, osInitTask y osInit, y avanza
+ *  el sistema tick a tick con portTestTick. Las tareas nunca se ejecutan: la prueba las
+ *  bloquea y libera modificando su estado y observa en osTestGetControl()->current_task la
+ *  tarea que eligió el scheduler en cada tick. Verifica:
+ *   - round_robin: las tareas READY de igual prioridad se turnan en orden fijo, una por tick.
+ *   - starvation: una tarea que vuelve a READY recibe el CPU dentro de una vuelta de su
+ *     prioridad, las tareas de menor prioridad se ejecutan cuando todas las de mayor
+ *     prioridad están bloqueadas y la tarea idle solo se ejecuta sin tareas READY.
+ *   - random: RANDOM_SEQUENCES secuencias de estados aleatorios sobre MAX_TASK_NUMBER tareas
+ *     con prioridades aleatorias entre PRIORITY_MAX y PRIORITY_MIN. En cada tick se elige el
+ *     nivel de mayor prioridad con tareas READY, ninguna tarea READY espera más de una vuelta
+ *     de su nivel y el costo de la decisión no supera DECISION_MAX_CYCLES.
+ *
+ *  La semilla de las secuencias puede pasarse como argumento para reproducir una falla. Las
+ *  configuraciones con muchas tareas o prioridades se prueban con KERNEL_DEFS (ver Makefile).
+ *  Termina con código 1 si alguna verificación falla.
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: JAMM
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "JAMMOS.h"
+
+#define RR_TASKS			3
+#define RR_ROUNDS			100
+#define STARVE_TICKS		60
+
+#define RANDOM_SEED			0x4A4D4D53u	//"JMMS", semilla por defecto de las secuencias
+#define RANDOM_SEQUENCES	2000
+#define RANDOM_STEPS		64
+#define PRIORITY_LEVELS		(PRIORITY_MIN - PRIORITY_MAX + 1)
+
+/*
+ * Costo máximo de una decisión (tick, scheduler y cambio de contexto) medido con el reloj del
+ * host en ns. El host puede desalojar al harness en cualquier momento, por lo que se admite
+ * que una de cada DECISION_OUTLIERS decisiones supere la cota
+ */
+#define DECISION_MAX_CYCLES	20000
+#define DECISION_OUTLIERS	1000
+
+static uint32_t failures = 0;
+
+#define CHECK(cond)																	\
+	do {																			\
+		if(!(cond))  {																\
+			printf("FALLA %s:%d: %s\n", __FILE__, __LINE__, #cond);				\
+			failures++;																\
+		}																			\
+	} while(0)
+
+OS_TASK(taskA);
+OS_TASK(taskB);
+OS_TASK(taskC);
+OS_TASK(taskLow);
+
+static uint32_t randomStacks[MAX_TASK_NUMBER][STACK_SIZE/4];
+static task randomTasks[MAX_TASK_NUMBER];
+static uint32_t randomState;
+
+static void taskBody(void)
+{
+	while(1)  {
+	}
+}
+
+/*
+ * Ningún error del OS es esperado en estas pruebas, el hook por defecto se queda en un lazo
+ */
+void errorHook(void *caller)
+{
+	printf("FALLA errorHook, err=%d\n", (int)osTestGetControl()->err);
+	exit(1);
+}
+
+/*
+ * Generador xorshift32, la secuencia depende solo de la semilla y no de la libc del host
+ */
+static uint32_t randomNext(void)
+{
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+	return randomState;
+}
+
+static uint32_t hostCycles(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec);
+}
+
+static task* runTick(void)
+{
+	portTestTick();
+	CHECK(portTestIrqDisabled() == 0);
+	return osTestGetControl()->current_task;
+}
+
+/*
+ * El primer tick desde el reset pone en ejecución la tarea idle, el scheduling de las tareas
+ * de la prueba empieza en el tick siguiente
+ */
+static void startOs(void)
+{
+	osInit();
+	CHECK(runTick() == osTestGetIdleTask());
+}
+
+/*************************************************************************************************
+	 *  @brief Round robin entre tareas de igual prioridad
+     *
+     *  @details
+     *   Con RR_TASKS tareas READY de igual prioridad cada tarea debe ejecutarse exactamente una
+     *   vez en cada vuelta de RR_TASKS ticks y siempre en el mismo orden.
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+static void testRoundRobin(void)
+{
+	task *order[RR_TASKS];
+	uint32_t runs[RR_TASKS] = {0};
+	task *current;
+	uint32_t i;
+	uint8_t j;
+
+	osTestReset();
+	osInitTask(taskBody, &taskA, 1);
+	osInitTask(taskBody, &taskB, 1);
+	osInitTask(taskBody, &taskC, 1);
+	startOs();
+
+	for(j = 0; j < RR_TASKS; j++)
+		order[j] = runTick();
+
+	CHECK(order[0] != order[1] && order[1] != order[2] && order[0] != order[2]);
+
+	for(i = 0; i < RR_TASKS * RR_ROUNDS; i++)  {
+		current = runTick();
+		CHECK(current == order[i % RR_TASKS]);
+		for(j = 0; j < RR_TASKS; j++)
+			if(current == order[j])
+				runs[j]++;
+	}
+
+	for(j = 0; j < RR_TASKS; j++)
+		CHECK(runs[j] == RR_ROUNDS);
+}
+
+/*************************************************************************************************
+	 *  @brief Ausencia de inanición
+     *
+     *  @details
+     *   Dos tareas de igual prioridad y una de menor prioridad. Con las dos READY la de menor
+     *   prioridad no se ejecuta. Mientras una está bloqueada la otra se ejecuta en todos los
+     *   ticks y al liberarse recibe el CPU dentro de una vuelta. Con las dos bloqueadas se
+     *   ejecuta la de menor prioridad, y con todas bloqueadas la tarea idle.
+     *
+	 *  @param 		None.
+	 *  @return     None.
+***************************************************************************************************/
+static void testStarvation(void)
+{
+	uint32_t runsA;
+	uint32_t i;
+	task *current;
+
+	osTestReset();
+	osInitTask(taskBody, &taskA, 1);
+	osInitTask(taskBody, &taskB, 1);
+	osInitTask(taskBody, &taskLow, 2);
+	startOs();
+
+	for(i = 0; i < STARVE_TICKS; i++)
+		CHECK(runTick() != &taskLow);
+
+	taskA.state = BLOCKED;
+	for(i = 0; i < STARVE_TICKS; i++)
+		CHECK(runTick() == &taskB);
+
+	taskA.state = READY;
+	runsA = 0;
+	for(i = 0; i < 2; i++)
+		if(runTick() == &taskA)
+			runsA++;
+	CHECK(runsA == 1);
+
+	taskA.state = BLOCKED;
+	taskB.state = BLOCKED;
+	for(i = 0; i < STARVE_TICKS; i++)
+		CHECK(runTick() == &taskLow);
+
+	taskLow.state = BLOCKED;
+	for(i = 0; i < STARVE_TICKS; i++)
+		CHECK(runTick() == osTestGetIdleTask());
+
+	taskB.state = READY;
+	current = runTick();
+	CHECK(current == &taskB);
+	CHECK(taskLow.state == BLOCKED);
+}
+
+/*************************************************************************************************
+	 *  @brief Secuencias aleatorias de estados de tareas
+     *
+     *  @details
+     *   En cada secuencia inicializa MAX_TASK_NUMBER tareas con prioridades aleatorias y en
+     *   cada tick bloquea o libera tareas al azar, incluida la tarea en ejecución. Luego del
+     *   tick verifica que la tarea elegida pertenezca al nivel de mayor prioridad con tareas
+     *   READY (o que sea idle si no hay ninguna) y que ninguna tarea de ese nivel haya esperado
+     *   una vuelta completa, es decir tantos ticks como tareas tiene su nivel. Los ticks en que
+     *   se ejecuta un nivel de mayor prioridad no cuentan como espera. El costo de cada tick se
+     *   mide con el contador de ciclos del port usando el reloj del host como fuente.
+     *
+	 *  @param seed		Semilla de las secuencias, distinta de cero.
+	 *  @return     None.
+***************************************************************************************************/
+static void testRandom(uint32_t seed)
+{
+	uint8_t levelTasks[PRIORITY_LEVELS];
+	uint32_t waited[MAX_TASK_NUMBER];
+	uint32_t sequence;
+	uint32_t step;
+	uint32_t start;
+	uint32_t cost;
+	uint32_t maxCost = 0;
+	uint64_t totalCost = 0;
+	uint32_t outliers = 0;
+	uint32_t decisions = 0;
+	uint32_t failuresBefore;
+	uint8_t best;
+	uint8_t i;
+	task *current;
+
+	randomState = seed;
+	portTestSetCycleSource(hostCycles);
+
+	for(sequence = 0; sequence < RANDOM_SEQUENCES; sequence++)  {
+		failuresBefore = failures;
+
+		osTestReset();
+		for(i = 0; i < PRIORITY_LEVELS; i++)
+			levelTasks[i] = 0;
+		for(i = 0; i < MAX_TASK_NUMBER; i++)  {
+			randomTasks[i] = (task){ .stack = randomStacks[i] };
+			osInitTask(taskBody, &randomTasks[i], PRIORITY_MAX + randomNext() % PRIORITY_LEVELS);
+			levelTasks[randomTasks[i].priority - PRIORITY_MAX]++;
+			waited[i] = 0;
+		}
+		startOs();
+
+		for(step = 0; step < RANDOM_STEPS; step++)  {
+			best = PRIORITY_MIN + 1;
+			for(i = 0; i < MAX_TASK_NUMBER; i++)  {
+				if(randomTasks[i].state == BLOCKED)  {
+					if(randomNext() % 4 == 0)
+						randomTasks[i].state = READY;
+				}
+				else if(randomNext() % 8 == 0)
+					randomTasks[i].state = BLOCKED;
+
+				if(randomTasks[i].state == BLOCKED)
+					waited[i] = 0;
+				else if(randomTasks[i].priority < best)
+					best = randomTasks[i].priority;
+			}
+
+			start = portGetCycles();
+			current = runTick();
+			cost = portGetCycles() - start;
+
+			decisions++;
+			totalCost += cost;
+			if(cost > maxCost)
+				maxCost = cost;
+			if(cost > DECISION_MAX_CYCLES)
+				outliers++;
+
+			if(best > PRIORITY_MIN)  {
+				CHECK(current == osTestGetIdleTask());
+				continue;
+			}
+
+			CHECK(current != osTestGetIdleTask() && current->state == RUNNING);
+			CHECK(current->priority == best);
+
+			for(i = 0; i < MAX_TASK_NUMBER; i++)  {
+				if(randomTasks[i].state == BLOCKED || randomTasks[i].priority != best)
+					continue;
+				if(&randomTasks[i] == current)
+					waited[i] = 0;
+				else
+					waited[i]++;
+				CHECK(waited[i] < levelTasks[best - PRIORITY_MAX]);
+			}
+		}
+
+		if(failures != failuresBefore)  {
+			printf("FALLA en la secuencia %u de la semilla 0x%08x\n", (unsigned)sequence,
+					(unsigned)seed);
+			break;
+		}
+	}
+
+	portTestSetCycleSource(NULL);
+
+	printf("random: %u decisiones, costo avg=%u max=%u ns, %u sobre la cota de %u ns\n",
+			(unsigned)decisions, (unsigned)(totalCost / decisions),
+			(unsigned)maxCost, (unsigned)outliers, (unsigned)DECISION_MAX_CYCLES);
+	CHECK(outliers <= decisions / DECISION_OUTLIERS);
+}
+
+int main(int argc, char *argv[])
+{
+	uint32_t seed = RANDOM_SEED;
+
+	if(argc > 1)
+		seed = (uint32_t)strtoul(argv[1], NULL, 0);
+
+	testRoundRobin();
+	testStarvation();
+	testRandom(seed != 0 ? seed : RANDOM_SEED);
+
+	printf("%s\n", failures ? "FALLA" : "OK");
+	return failures ? 1 : 0;
+}
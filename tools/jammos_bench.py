@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+#
+# jammos_bench.py
+#
+#  Created on: 19 oct. 2026
+#      Author: JAMM
+#
+# Compara la salida del benchmark del kernel (bench/main.c) contra una ejecución de
+# referencia. Informa la variación del promedio de cada medición BENCH y del valor de cada
+# medición BENCH_RATE y termina con código 1 si alguna empeora más que la tolerancia, para
+# utilizarlo en integración continua. Un aumento empeora salvo en las mediciones BENCH_RATE
+# con better=higher, como las tasas de lecturas por segundo.
+#
+# Uso: jammos_bench.py referencia.txt actual.txt [--tolerance 5]
+
+import argparse
+import sys
+
+
+def read_results(path):
+    """Devuelve {(name, size): (valor, mayor es mejor)} con las líneas BENCH y BENCH_RATE."""
+    results = {}
+    done = False
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if line == "BENCH_DONE":
+                done = True
+            record = line.split()
+            if not record or record[0] not in ("BENCH", "BENCH_RATE"):
+                continue
+            fields = dict(item.split("=", 1) for item in record[1:])
+            key = (fields["name"], fields.get("size", ""))
+            if record[0] == "BENCH":
+                results[key] = (int(fields["avg"]), False)
+            else:
+                results[key] = (int(fields["value"]), fields["better"] == "higher")
+    if not done:
+        sys.exit("%s: el benchmark no terminó (falta BENCH_DONE)" % path)
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compara dos ejecuciones del benchmark de JAMMOS")
+    parser.add_argument("reference", help="salida de referencia")
+    parser.add_argument("current", help="salida a comparar")
+    parser.add_argument("--tolerance", type=float, default=5.0,
+                        help="empeoramiento máximo admitido en porcentaje")
+    args = parser.parse_args()
+
+    reference = read_results(args.reference)
+    current = read_results(args.current)
+    regressions = 0
+
+    for key in sorted(reference):
+        name = key[0] + ("[%s]" % key[1] if key[1] else "")
+        if key not in current:
+            print("%-20s falta en %s" % (name, args.current))
+            regressions += 1
+            continue
+        before, higher_is_better = reference[key]
+        after = current[key][0]
+        change = 100.0 * (after - before) / before if before else 0.0
+        worse = -change if higher_is_better else change
+        mark = ""
+        if worse > args.tolerance:
+            mark = "  REGRESION"
+            regressions += 1
+        print("%-20s %10d -> %10d  %+7.2f %%%s" % (name, before, after, change, mark))
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+#
+# jammos_trace.py
+#
+#  Created on: 19 oct. 2026
+#      Author: JAMM
+#
+# Decodifica el volcado binario generado por osTraceDump() y produce un archivo JSON en
+# formato Chrome trace (chrome://tracing o https://ui.perfetto.dev) con la línea de tiempo
+# de las tareas, las interrupciones y los eventos del kernel.
+#
+# Uso: jammos_trace.py volcado.bin [-o trace.json]
+
+import argparse
+import json
+import struct
+import sys
+
+TRACE_MAGIC = 0x4352544A
+HEADER = struct.Struct("<IHHI")
+EVENT = struct.Struct("<IBBI")
+EVENT_V1 = struct.Struct("<IBBH")          # versión 1, arg de 16 bits
+
+TICK, SCHEDULE, SWITCH, IRQ_ENTER, IRQ_EXIT, QUEUE_PUT, QUEUE_GET, QUEUE_BLOCK, \
+    SEM_GIVE, SEM_TAKE, SEM_BLOCK, DELAY, TASK_CREATE, TASK_DELETE, TIMEOUT, USER = range(16)
+
+EVENT_NAMES = {
+    TICK: "tick", SCHEDULE: "schedule", SWITCH: "switch",
+    IRQ_ENTER: "irq_enter", IRQ_EXIT: "irq_exit",
+    QUEUE_PUT: "queue_put", QUEUE_GET: "queue_get", QUEUE_BLOCK: "queue_block",
+    SEM_GIVE: "sem_give", SEM_TAKE: "sem_take", SEM_BLOCK: "sem_block",
+    DELAY: "delay", TASK_CREATE: "task_create", TASK_DELETE: "task_delete",
+    TIMEOUT: "timeout",
+}
+
+IDLE_ID = 0xFF
+NO_TASK = 0xFE
+IRQ_TID = 1000
+
+
+def task_name(task_id):
+    if task_id == IDLE_ID:
+        return "idle"
+    if task_id == NO_TASK:
+        return "reset"
+    return "task %d" % task_id
+
+
+def read_dump(data):
+    magic, version, quantity, cpu_hz = HEADER.unpack_from(data, 0)
+    if magic != TRACE_MAGIC:
+        raise ValueError("el archivo no es un volcado de osTraceDump")
+    event = EVENT_V1 if version == 1 else EVENT
+    events = []
+    offset = HEADER.size
+    for _ in range(quantity):
+        events.append(event.unpack_from(data, offset))
+        offset += event.size
+    return version, cpu_hz, events
+
+
+def unwrap(events):
+    # DWT CYCCNT es de 32 bits, se extiende la marca de tiempo para que sea monótona
+    high = 0
+    previous = None
+    for timestamp, event, task_id, arg in events:
+        if previous is not None and timestamp < previous:
+            high += 1 << 32
+        previous = timestamp
+        yield high + timestamp, event, task_id, arg
+
+
+def to_chrome(cpu_hz, events):
+    us = 1e6 / cpu_hz
+    out = []
+    running = None
+    running_since = None
+    irq_start = {}
+    tids = set()
+
+    for cycles, event, task_id, arg in unwrap(events):
+        ts = cycles * us
+        if running is None:
+            running, running_since = task_id, ts
+        if event == SWITCH:
+            out.append({"name": task_name(running), "ph": "X", "pid": 0, "tid": running,
+                        "ts": running_since, "dur": ts - running_since})
+            tids.add(running)
+            running, running_since = arg, ts
+        elif event == IRQ_ENTER:
+            irq_start[arg] = ts
+        elif event == IRQ_EXIT and arg in irq_start:
+            start = irq_start.pop(arg)
+            out.append({"name": "IRQ %d" % arg, "ph": "X", "pid": 0, "tid": IRQ_TID,
+                        "ts": start, "dur": ts - start})
+        else:
+            name = EVENT_NAMES.get(event, "user %d" % (event - USER))
+            out.append({"name": name, "ph": "i", "s": "t", "pid": 0, "tid": task_id,
+                        "ts": ts, "args": {"arg": arg}})
+            tids.add(task_id)
+
+    for tid in sorted(tids):
+        out.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": tid,
+                    "args": {"name": task_name(tid)}})
+    out.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": IRQ_TID,
+                "args": {"name": "IRQ"}})
+    return {"traceEvents": out, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decodifica un volcado de trace de JAMMOS")
+    parser.add_argument("dump", help="archivo binario generado por osTraceDump")
+    parser.add_argument("-o", "--output", help="archivo JSON de salida (por defecto stdout)")
+    args = parser.parse_args()
+
+    with open(args.dump, "rb") as f:
+        _, cpu_hz, events = read_dump(f.read())
+
+    trace = to_chrome(cpu_hz, events)
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(trace, f)
+    else:
+        json.dump(trace, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()